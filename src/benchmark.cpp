@@ -0,0 +1,412 @@
+#include "benchmark.h"
+#include "innertube/innertubeexception.h"
+#include "mainwindow.h"
+#include "qttubeapplication.h"
+#include "ui/browsehelper.h"
+#include "ui/forms/livechat/livechatloadgenerator.h"
+#include "ui/forms/livechat/livechatwindow.h"
+#include "ui/views/viewcontroller.h"
+#include "ui/views/watchview.h"
+#include "ui/widgets/topbar/topbar.h"
+#include "ui/widgets/webengineplayer/webengineplayer.h"
+#include "utils/httpfixtures.h"
+#include "utils/networkmetrics.h"
+#include "utils/osutils.h"
+#include "utils/stringutils.h"
+#include <QDir>
+#include <QMouseEvent>
+#include <QTextStream>
+#include <QTimer>
+#include <QWindow>
+#include <numeric>
+
+constexpr int BenchmarkTimeout = 60000;
+constexpr int ChatStageDuration = 4000;
+constexpr int DefaultMouseMoves = 5000;
+constexpr int DefaultNotifyEvents = 1000000;
+constexpr int FrameInterval = 16;
+constexpr int MaxChatStages = 12;
+constexpr int MaxFrameTime = 50;
+constexpr int MouseMovesPerFrame = 8; // about what a 500 Hz mouse sends
+// the player only reports progress once it's a second past the last report, so start past that
+constexpr int PlayerTestPageStart = 10;
+
+namespace
+{
+    // the shape of the QApplication::notify() override the main window's event filter replaced:
+    // a name check on every event in the application before it went anywhere
+    bool notifyWithOldOverride(QObject* receiver, QEvent* event)
+    {
+        if (receiver->objectName() == "MainWindowWindow")
+        {
+            switch (event->type())
+            {
+            case QEvent::KeyPress:
+            case QEvent::MouseMove:
+                return true;
+            default: break;
+            }
+        }
+
+        return QCoreApplication::sendEvent(receiver, event);
+    }
+
+    qint64 percentile(QList<qint64> values, double p)
+    {
+        if (values.isEmpty())
+            return 0;
+        std::sort(values.begin(), values.end());
+        return values[std::min<qsizetype>(values.size() * p, values.size() - 1)];
+    }
+}
+
+bool Benchmark::ChatStage::keptUp() const
+{
+    return frameP95 <= MaxFrameTime && delivered >= rate * 0.9;
+}
+
+Benchmark::Benchmark(const QString& scenario, QObject* parent) : QObject(parent), m_scenario(scenario) {}
+
+void Benchmark::fail(const QString& reason)
+{
+    QTextStream(stderr) << "benchmark " << m_scenario << " failed: " << reason << Qt::endl;
+    qApp->exit(EXIT_FAILURE);
+}
+
+void Benchmark::finishChatStage()
+{
+    const qint64 elapsed = m_clock.restart();
+    // what the window actually got into its list, not what was offered to it
+    const qint64 messages = m_chatWindow->messagesAdded();
+
+    const ChatStage stage {
+        .batchMean = m_batchTimes.isEmpty()
+            ? 0 : std::accumulate(m_batchTimes.begin(), m_batchTimes.end(), 0.0) / m_batchTimes.size(),
+        .delivered = (messages - m_stageMessages) * 1000.0 / elapsed,
+        .frameP50 = percentile(m_frameTimes, 0.5),
+        .frameP95 = percentile(m_frameTimes, 0.95),
+        .rate = m_chatGenerator->options().messagesPerSecond
+    };
+
+    m_chatStages.append(stage);
+    m_batchTimes.clear();
+    m_frameTimes.clear();
+    m_stageMessages = messages;
+
+    if (!stage.keptUp() || m_chatStages.size() == MaxChatStages)
+        reportChat();
+    else
+        m_chatGenerator->setMessagesPerSecond(stage.rate * 3 / 2);
+}
+
+void Benchmark::report(qint64 populated)
+{
+    int requests{};
+    for (const NetworkMetrics::EndpointStats& stats : NetworkMetrics::instance()->endpoints())
+        requests += stats.requests;
+
+    const qint64 peakMemory = OSUtils::peakMemoryUsage();
+
+    QTextStream out(stdout);
+    out << "scenario: " << m_scenario << Qt::endl
+        << "time to first item: " << (m_firstItem != -1 ? m_firstItem : populated) << " ms" << Qt::endl
+        << "first item since launch: "
+        << (m_firstItemSinceLaunch != -1 ? QString::number(m_firstItemSinceLaunch) + " ms" : "unknown") << Qt::endl
+        << "full population: " << populated << " ms" << Qt::endl
+        << "peak rss: " << (peakMemory != -1 ? StringUtils::bytesString(peakMemory) : "unknown") << Qt::endl
+        << "requests: " << requests << Qt::endl;
+
+    qApp->exit(EXIT_SUCCESS);
+}
+
+void Benchmark::reportChat()
+{
+    m_chatGenerator->stop();
+    m_frameProbe->stop();
+
+    QTextStream out(stdout);
+    out << "scenario: " << m_scenario << Qt::endl;
+
+    const ChatStage* sustained{};
+    for (qsizetype i = 0; i < m_chatStages.size(); ++i)
+    {
+        const ChatStage& stage = m_chatStages[i];
+        out << "stage " << i + 1 << ": " << stage.rate << " msg/s offered, "
+            << qRound(stage.delivered) << " msg/s delivered, "
+            << "frame p50 " << stage.frameP50 << " ms, p95 " << stage.frameP95 << " ms, "
+            << "batch " << QString::number(stage.batchMean, 'f', 1) << " ms" << Qt::endl;
+        if (stage.keptUp())
+            sustained = &stage;
+    }
+
+    const qint64 peakMemory = OSUtils::peakMemoryUsage();
+
+    if (sustained)
+    {
+        out << "sustained: " << qRound(sustained->delivered) << " msg/s" << Qt::endl
+            << "frame time at sustained rate: p50 " << sustained->frameP50 << " ms, p95 " << sustained->frameP95 << " ms" << Qt::endl;
+    }
+    else
+    {
+        out << "sustained: none, the ui fell behind at the starting rate" << Qt::endl;
+    }
+
+    out << "peak rss: " << (peakMemory != -1 ? StringUtils::bytesString(peakMemory) : "unknown") << Qt::endl;
+    qApp->exit(EXIT_SUCCESS);
+}
+
+void Benchmark::reportMouseMoves(int startingEvaluations)
+{
+    const qint64 totalDispatch = std::accumulate(m_dispatchTimes.begin(), m_dispatchTimes.end(), qint64());
+    const int evaluations = MainWindow::topbar()->mouseMovesProcessed() - startingEvaluations;
+
+    QTextStream out(stdout);
+    out << "scenario: " << m_scenario << Qt::endl
+        << "moves: " << m_mouseMoves << " over " << m_clock.elapsed() << " ms" << Qt::endl
+        << "dispatch: " << QString::number(totalDispatch / 1000.0 / m_mouseMoves, 'f', 2) << " us per move, "
+        << "frame p50 " << QString::number(percentile(m_dispatchTimes, 0.5) / 1000.0, 'f', 1) << " us, "
+        << "p95 " << QString::number(percentile(m_dispatchTimes, 0.95) / 1000.0, 'f', 1) << " us" << Qt::endl
+        << "top bar evaluations: " << evaluations << Qt::endl;
+
+    qApp->exit(EXIT_SUCCESS);
+}
+
+void Benchmark::reportPlayer()
+{
+    const qint64 peakMemory = OSUtils::peakMemoryUsage();
+
+    QTextStream out(stdout);
+    out << "scenario: " << m_scenario << Qt::endl
+        << "first frame, prewarmed player: " << m_firstFrames[0] << " ms" << Qt::endl
+        << "first frame, reused player: " << m_firstFrames[1] << " ms" << Qt::endl
+        << "peak rss: " << (peakMemory != -1 ? StringUtils::bytesString(peakMemory) : "unknown") << Qt::endl;
+
+    qApp->exit(EXIT_SUCCESS);
+}
+
+void Benchmark::run()
+{
+    QTimer::singleShot(BenchmarkTimeout, this, [this] {
+        // a chat run that hasn't found its ceiling yet still has stages worth reporting
+        if (m_chatGenerator)
+            reportChat();
+        else
+            fail("timed out");
+    });
+
+    const QString type = m_scenario.section(':', 0, 0);
+    const QString arg = m_scenario.section(':', 1);
+
+    if (HttpFixtures::isReplaying() && (type == "channel" || type == "video"))
+        QTextStream(stderr) << "note: " << type << " pages aren't replayed, they still load from InnerTube" << Qt::endl;
+
+    if (type == "home")
+    {
+        runList([](ContinuableListWidget* list) { BrowseHelper::instance()->browseHome(list); });
+    }
+    else if (type == "trending")
+    {
+        runList([](ContinuableListWidget* list) { BrowseHelper::instance()->browseTrending(list); });
+    }
+    else if (type == "search" && !arg.isEmpty())
+    {
+        runList([arg](ContinuableListWidget* list) { BrowseHelper::instance()->search(list, arg); });
+    }
+    else if (type == "chat")
+    {
+        runChat(arg);
+    }
+    else if (type == "mousemove")
+    {
+        bool ok = true;
+        const int count = arg.isEmpty() ? DefaultMouseMoves : arg.toInt(&ok);
+        if (ok && count > 0)
+            runMouseMoves(count);
+        else
+            fail("mouse move count has to be a positive number");
+    }
+    else if (type == "channel" && !arg.isEmpty())
+    {
+        // channels are loaded synchronously, so there's no first item to wait on
+        m_clock.start();
+        ViewController::loadChannel(arg);
+        report(m_clock.elapsed());
+    }
+    else if (type == "notify")
+    {
+        bool ok = true;
+        const int count = arg.isEmpty() ? DefaultNotifyEvents : arg.toInt(&ok);
+        if (ok && count > 0)
+            runNotify(count);
+        else
+            fail("event count has to be a positive number");
+    }
+    else if (type == "player")
+    {
+        runPlayer();
+    }
+    else if (type == "video" && !arg.isEmpty())
+    {
+        m_clock.start();
+        ViewController::loadVideo(arg);
+
+        WatchView* watchView = qobject_cast<WatchView*>(MainWindow::centralWidget()->currentWidget());
+        connect(watchView, &WatchView::loadFailed, this, [this](const InnertubeException& ie) { fail(ie.message()); });
+        connect(watchView, &WatchView::metadataLoaded, this, [this] { report(m_clock.elapsed()); });
+    }
+    else
+    {
+        fail("unknown scenario");
+    }
+}
+
+void Benchmark::runChat(const QString& options)
+{
+    // synthetic avatars and emojis don't exist anywhere, so keep their requests off the network
+    if (!HttpFixtures::isReplaying())
+        HttpFixtures::startReplaying(QDir::temp().filePath("qttube-synthetic-chat"));
+
+    m_chatGenerator = new LiveChatLoadGenerator(LiveChatLoadGenerator::Options::fromString(options), this);
+    m_chatWindow = new LiveChatWindow;
+    m_chatWindow->setAttribute(Qt::WA_DeleteOnClose);
+    m_chatWindow->show();
+
+    // connected before the window so the clock starts before the batch is processed
+    connect(m_chatGenerator, &LiveChatLoadGenerator::responseReady, this, [this] { m_chatBatchClock.start(); });
+    m_chatWindow->initializeSynthetic(m_chatGenerator);
+    connect(m_chatWindow, &LiveChatWindow::getLiveChatFinished, this, [this] {
+        m_batchTimes.append(m_chatBatchClock.elapsed());
+    });
+
+    // a timer that should fire every frame. if the event loop is busy, the gaps between ticks grow
+    m_frameProbe = new QTimer(this);
+    m_frameProbe->setTimerType(Qt::PreciseTimer);
+    connect(m_frameProbe, &QTimer::timeout, this, [this] { m_frameTimes.append(m_frameClock.restart()); });
+
+    QTimer* stageTimer = new QTimer(this);
+    connect(stageTimer, &QTimer::timeout, this, &Benchmark::finishChatStage);
+
+    m_clock.start();
+    m_frameClock.start();
+    m_frameProbe->start(FrameInterval);
+    m_chatGenerator->start();
+    stageTimer->start(ChatStageDuration);
+}
+
+void Benchmark::runList(const std::function<void(ContinuableListWidget*)>& load)
+{
+    m_list = new ContinuableListWidget;
+    m_list->setAttribute(Qt::WA_DeleteOnClose);
+    m_list->resize(MainWindow::size());
+    m_list->toggleListGridLayout();
+    m_list->show();
+
+    connect(m_list->model(), &QAbstractItemModel::rowsInserted, this, [this] {
+        if (m_firstItem == -1)
+        {
+            m_firstItem = m_clock.elapsed();
+            if (m_launchClock.isValid())
+                m_firstItemSinceLaunch = m_launchClock.elapsed();
+        }
+    });
+    connect(m_list, &ContinuableListWidget::populatingChanged, this, [this](bool populating) {
+        if (!populating)
+            report(m_clock.elapsed());
+    });
+
+    m_clock.start();
+    load(m_list);
+}
+
+void Benchmark::runMouseMoves(int count)
+{
+    QWindow* window = MainWindow::topbar()->window()->windowHandle();
+    if (!window)
+    {
+        fail("the main window isn't shown");
+        return;
+    }
+
+    if (!qtTubeApp->settings().autoHideTopBar)
+        QTextStream(stderr) << "note: auto-hiding the top bar is off, so moves are only dispatched, not acted on" << Qt::endl;
+
+    const int startingEvaluations = MainWindow::topbar()->mouseMovesProcessed();
+    QTimer* moveTimer = new QTimer(this);
+    moveTimer->setTimerType(Qt::PreciseTimer);
+    connect(moveTimer, &QTimer::timeout, this, [this, count, moveTimer, startingEvaluations, window] {
+        QElapsedTimer dispatchClock;
+        dispatchClock.start();
+
+        for (int i = 0; i < MouseMovesPerFrame && m_mouseMoves < count; ++i, ++m_mouseMoves)
+        {
+            // sweeps down the window and back up, in and out of the top bar
+            const QPointF pos(window->width() / 2, std::abs(m_mouseMoves * 4 % (window->height() * 2) - window->height()));
+            QMouseEvent event(QEvent::MouseMove, pos, window->mapToGlobal(pos.toPoint()),
+                              Qt::NoButton, Qt::NoButton, Qt::NoModifier);
+            QCoreApplication::sendEvent(window, &event);
+        }
+
+        m_dispatchTimes.append(dispatchClock.nsecsElapsed());
+
+        if (m_mouseMoves == count)
+        {
+            moveTimer->stop();
+            // the top bar may still have the last position waiting on its throttle
+            QTimer::singleShot(FrameInterval * 2, this, std::bind(&Benchmark::reportMouseMoves, this, startingEvaluations));
+        }
+    });
+
+    m_clock.start();
+    moveTimer->start(FrameInterval);
+}
+
+void Benchmark::runNotify(int count)
+{
+    QObject receiver;
+    QTimerEvent event(0);
+
+    auto nsPerEvent = [&receiver, &event](int events, bool (*send)(QObject*, QEvent*)) {
+        QElapsedTimer clock;
+        clock.start();
+        for (int i = 0; i < events; ++i)
+            send(&receiver, &event);
+        return double(clock.nsecsElapsed()) / events;
+    };
+
+    // a round of each first so neither pays for warming up caches
+    nsPerEvent(count / 10, &QCoreApplication::sendEvent);
+    nsPerEvent(count / 10, &notifyWithOldOverride);
+
+    const double plain = nsPerEvent(count, &QCoreApplication::sendEvent);
+    const double withOverride = nsPerEvent(count, &notifyWithOldOverride);
+
+    QTextStream out(stdout);
+    out << "scenario: " << m_scenario << Qt::endl
+        << "events: " << count << " timer events to a plain object" << Qt::endl
+        << "without override: " << QString::number(plain, 'f', 1) << " ns/event" << Qt::endl
+        << "with old override: " << QString::number(withOverride, 'f', 1) << " ns/event ("
+        << QString::number(withOverride - plain, 'f', 1) << " ns more)" << Qt::endl;
+
+    qApp->exit(EXIT_SUCCESS);
+}
+
+void Benchmark::runPlayer()
+{
+    WebEnginePlayer* player = WebEnginePlayer::acquire(nullptr);
+    player->resize(640, 360);
+    player->show();
+
+    connect(player, &WebEnginePlayer::progressChanged, this, [this, player] {
+        m_firstFrames.append(m_clock.elapsed());
+        // this disconnects from progressChanged and puts the player back in the pool for the next run to pick up
+        WebEnginePlayer::release(player);
+
+        if (m_firstFrames.size() == 2)
+            reportPlayer();
+        else
+            runPlayer();
+    });
+
+    m_clock.start();
+    player->playTestPage(PlayerTestPageStart);
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <QElapsedTimer>
+#include <QObject>
+
+class ContinuableListWidget;
+class LiveChatLoadGenerator;
+class LiveChatWindow;
+class QTimer;
+
+// drives one load end to end, prints how long it took and exits (--benchmark).
+// scenarios are home, trending, search:<query>, channel:<id>, video:<id>, player, chat:<generator options>
+// mousemove[:<count>] and notify[:<count>].
+// run once with --record, then with --replay to take the network out of it. home, trending, search and chat
+// replay completely. channel and video pages are loaded through innertube-qt's parsed requests, which can't
+// be recorded, so only their images and third-party lookups are replayed.
+// chat feeds a live chat window synthetic messages at an increasing rate until frames start dropping.
+// player times the first frame of a local test page through the player pool, once with the prewarmed player
+// and once more with the player that load gave back, like moving on to the next video.
+// mousemove sends the main window synthetic mouse moves at about 500 Hz and times how long they take to dispatch.
+// notify times sending timer events to a plain object, with and without the work the old QApplication::notify()
+// override did on every event, which is what every paint, timer and network event used to pay.
+class Benchmark : public QObject
+{
+    Q_OBJECT
+public:
+    explicit Benchmark(const QString& scenario, QObject* parent = nullptr);
+    // call as early in main() as possible, list scenarios report their first item relative to it (cold start)
+    static void markLaunch() { m_launchClock.start(); }
+public slots:
+    void run();
+private:
+    struct ChatStage
+    {
+        double batchMean{};
+        double delivered{};
+        qint64 frameP50{};
+        qint64 frameP95{};
+        int rate{};
+
+        bool keptUp() const;
+    };
+
+    static inline QElapsedTimer m_launchClock;
+
+    QList<qint64> m_batchTimes;
+    QElapsedTimer m_chatBatchClock;
+    LiveChatLoadGenerator* m_chatGenerator{};
+    QList<ChatStage> m_chatStages;
+    LiveChatWindow* m_chatWindow{};
+    QElapsedTimer m_clock;
+    QList<qint64> m_dispatchTimes; // ns, per frame's worth of mouse moves
+    qint64 m_firstItem = -1;
+    qint64 m_firstItemSinceLaunch = -1;
+    QList<qint64> m_firstFrames;
+    QElapsedTimer m_frameClock;
+    QTimer* m_frameProbe{};
+    QList<qint64> m_frameTimes;
+    ContinuableListWidget* m_list{};
+    int m_mouseMoves{};
+    QString m_scenario;
+    qint64 m_stageMessages{};
+
+    void fail(const QString& reason);
+    void finishChatStage();
+    void report(qint64 populated);
+    void reportChat();
+    void reportMouseMoves(int startingEvaluations);
+    void reportPlayer();
+    void runChat(const QString& options);
+    void runList(const std::function<void(ContinuableListWidget*)>& load);
+    void runMouseMoves(int count);
+    void runNotify(int count);
+    void runPlayer();
+};
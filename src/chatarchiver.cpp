@@ -0,0 +1,207 @@
+#include "chatarchiver.h"
+#include "innertube.h"
+#include "utils/httpfixtures.h"
+#include "utils/networkmetrics.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QTimer>
+
+constexpr QLatin1String FeedFixtureName("livechat.jsonl");
+
+ChatArchiver::ChatArchiver(const QString& videoId, const QString& logPath, QObject* parent)
+    : QObject(parent), m_log(logPath), m_timer(new QTimer(this)), m_videoId(videoId)
+{
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &ChatArchiver::poll);
+}
+
+void ChatArchiver::fail(const QString& reason)
+{
+    QTextStream(stderr) << "Chat archiving failed: " << reason << Qt::endl;
+    QCoreApplication::exit(EXIT_FAILURE);
+}
+
+void ChatArchiver::finish()
+{
+    QTextStream(stdout) << "Archived " << m_written << " messages to " << m_log.fileName() << Qt::endl;
+    QCoreApplication::exit(EXIT_SUCCESS);
+}
+
+void ChatArchiver::poll()
+{
+    if (HttpFixtures::isReplaying())
+    {
+        // each line of the feed is one response, in the order they came in
+        const QByteArray line = m_feed.readLine();
+        if (line.isEmpty())
+            finish();
+        else
+            process(QJsonDocument::fromJson(line).object());
+        return;
+    }
+
+    auto reply = InnerTube::instance()->getRaw<InnertubeEndpoints::GetLiveChat>({
+        { "context", InnerTube::instance()->context()->toJson() },
+        { "continuation", m_continuation }
+    });
+    NetworkMetrics::instance()->track(reply, "GetLiveChat");
+
+    connect(reply, &InnertubeReply<InnertubeEndpoints::GetLiveChat>::exception, this, [this](const InnertubeException& ie) {
+        retry(ie.message());
+    });
+    connect(reply, &InnertubeReply<InnertubeEndpoints::GetLiveChat>::finishedRaw, this, [this](const QJsonValue& data) {
+        if (HttpFixtures::isRecording())
+        {
+            QFile feed(HttpFixtures::filePath(FeedFixtureName));
+            if (feed.open(QFile::WriteOnly | QFile::Append))
+                feed.write(QJsonDocument(data.toObject()).toJson(QJsonDocument::Compact) + '\n');
+        }
+
+        process(data);
+    });
+}
+
+void ChatArchiver::process(const QJsonValue& data)
+{
+    const auto endpoint = InnerTube::tryCreate<InnertubeEndpoints::GetLiveChat>(data);
+    if (!endpoint)
+    {
+        retry(endpoint.error().message());
+        return;
+    }
+
+    m_failures = 0;
+
+    const QJsonValue liveChatContinuation = endpoint->liveChatContinuation;
+    const qint64 receivedMs = QDateTime::currentMSecsSinceEpoch();
+
+    const QJsonArray actions = liveChatContinuation["actions"].toArray();
+    for (const QJsonValue& action : actions)
+    {
+        const QJsonValue item = action["addChatItemAction"]["item"];
+        if (!item.isObject())
+            continue;
+
+        // after a reconnect the server can hand back messages that were already written
+        const QString id = item.toObject().constBegin().value()["id"].toString();
+        if (m_recentIds.contains(id))
+            continue;
+
+        m_recentIds.insert(id);
+        m_recentIdOrder.enqueue(id);
+        if (m_recentIdOrder.size() > MaxRecentIds)
+            m_recentIds.remove(m_recentIdOrder.dequeue());
+
+        m_log.write(QJsonDocument(QJsonObject {
+            { "item", item },
+            { "receivedMs", receivedMs }
+        }).toJson(QJsonDocument::Compact) + '\n');
+        ++m_written;
+    }
+
+    // one flush per response, so a crash or kill loses at most what's in flight
+    m_log.flush();
+
+    const QJsonValue continuationObj = liveChatContinuation["continuations"][0];
+    const QJsonValue continuationData = continuationObj["invalidationContinuationData"].isObject()
+        ? continuationObj["invalidationContinuationData"] : continuationObj["timedContinuationData"];
+    if (const QString continuation = continuationData["continuation"].toString(); !continuation.isEmpty())
+    {
+        m_continuation = continuation;
+        m_timer->start(HttpFixtures::isReplaying() ? 0 : continuationData["timeoutMs"].toInt(DefaultPollInterval));
+    }
+    else if (HttpFixtures::isReplaying())
+    {
+        // a recorded feed doesn't need a continuation to go on, only more lines
+        m_timer->start(0);
+    }
+    else
+    {
+        // no continuation to follow (or just a reload one) means the stream is over
+        finish();
+    }
+}
+
+void ChatArchiver::resolve()
+{
+    auto reply = InnerTube::instance()->get<InnertubeEndpoints::Next>(m_videoId);
+    NetworkMetrics::instance()->track(reply, "Next");
+
+    connect(reply, &InnertubeReply<InnertubeEndpoints::Next>::exception, this, [this](const InnertubeException& ie) {
+        retry(ie.message());
+    });
+    connect(reply, &InnertubeReply<InnertubeEndpoints::Next>::finished, this, [this](const InnertubeEndpoints::Next& endpoint) {
+        const std::optional<InnertubeObjects::LiveChat>& conversationBar = endpoint.response.contents.conversationBar;
+        if (!conversationBar || conversationBar->continuations.isEmpty())
+        {
+            // nothing to reconnect to is only a failure if nothing was ever archived
+            if (m_continuation.isEmpty())
+                fail("Video not found or live chat is not available.");
+            else
+                finish();
+            return;
+        }
+
+        if (conversationBar->isReplay)
+        {
+            if (m_continuation.isEmpty())
+                fail("The stream is over and only has a chat replay.");
+            else
+                finish();
+            return;
+        }
+
+        m_continuation = conversationBar->continuations.front();
+        m_timer->start(0);
+    });
+}
+
+void ChatArchiver::retry(const QString& reason)
+{
+    if (HttpFixtures::isReplaying())
+    {
+        // a bad line in a recorded feed won't get any better by waiting
+        QTextStream(stderr) << "Skipping bad recorded response: " << reason << Qt::endl;
+        m_timer->start(0);
+        return;
+    }
+
+    ++m_failures;
+    const int interval = std::min(DefaultPollInterval << std::min(m_failures, 6), MaxRetryInterval);
+    QTextStream(stderr) << "Live chat request failed (" << reason << "), retrying in " << interval << " ms" << Qt::endl;
+
+    if (m_failures % ResolveAfterFailures == 0 || m_continuation.isEmpty())
+    {
+        QTimer::singleShot(interval, this, &ChatArchiver::resolve);
+    }
+    else
+    {
+        m_timer->start(interval);
+    }
+}
+
+void ChatArchiver::run()
+{
+    if (!m_log.open(QFile::WriteOnly | QFile::Append))
+    {
+        fail("Couldn't open " + m_log.fileName() + ": " + m_log.errorString());
+        return;
+    }
+
+    if (HttpFixtures::isReplaying())
+    {
+        m_feed.setFileName(HttpFixtures::filePath(FeedFixtureName));
+        if (!m_feed.open(QFile::ReadOnly))
+        {
+            fail("No recorded live chat in the replay directory.");
+            return;
+        }
+
+        m_timer->start(0);
+        return;
+    }
+
+    resolve();
+}
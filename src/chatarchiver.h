@@ -0,0 +1,43 @@
+#pragma once
+#include <QFile>
+#include <QQueue>
+#include <QSet>
+
+class QTimer;
+
+// follows a live chat with no ui at all and appends every message to a JSON Lines log (--archive-chat).
+// each line is {"item": <chat item renderer>, "receivedMs": <when it arrived>}, and --chat-log plays a log back
+// in a chat window. nothing but a window of recent message ids is kept in memory, so it can run for as long as the stream does.
+// with --record the raw responses go into the fixture directory too, and with --replay they're read back from there
+// instead of the network, so a recorded chat can be archived again offline.
+class ChatArchiver : public QObject
+{
+    Q_OBJECT
+public:
+    ChatArchiver(const QString& videoId, const QString& logPath, QObject* parent = nullptr);
+public slots:
+    void run();
+private:
+    static constexpr int DefaultPollInterval = 1000;
+    static constexpr int MaxRecentIds = 5000;
+    static constexpr int MaxRetryInterval = 60000;
+    // after this many failures in a row the continuation is likely dead, so get a fresh one
+    static constexpr int ResolveAfterFailures = 5;
+
+    QString m_continuation;
+    int m_failures{};
+    QFile m_feed;
+    QFile m_log;
+    QSet<QString> m_recentIds;
+    QQueue<QString> m_recentIdOrder;
+    QTimer* m_timer;
+    QString m_videoId;
+    qint64 m_written{};
+
+    void fail(const QString& reason);
+    void finish();
+    void poll();
+    void process(const QJsonValue& data);
+    void resolve();
+    void retry(const QString& reason);
+};
@@ -1,13 +1,69 @@
 #include "qttubeapplication.h"
+#include "benchmark.h"
+#include "chatarchiver.h"
 #include "innertube.h"
 #include "mainwindow.h"
 #include "ui/forms/livechat/livechatwindow.h"
+#include "utils/httpfixtures.h"
+#include "utils/networkmetrics.h"
+#include "utils/searchsuggestions.h"
+#include "utils/tracing.h"
+#include <QTimer>
+
+namespace
+{
+    // the archiver runs unattended for as long as a stream does, so it gets a plain QCoreApplication
+    // and never touches widgets, settings or accounts
+    int runChatArchiver(int argc, char* argv[])
+    {
+        QCoreApplication a(argc, argv);
+
+        QCommandLineParser parser;
+        parser.setApplicationDescription(QTTUBE_APP_DESC);
+
+        QCommandLineOption archiveChat("archive-chat", "Append a live chat's messages to a JSON Lines log without opening any windows.", "Video ID");
+        parser.addOption(archiveChat);
+
+        QCommandLineOption archiveFile("archive-file", "Where --archive-chat writes to. Defaults to <video ID>.chat.jsonl.", "File", "");
+        parser.addOption(archiveFile);
+
+        QCommandLineOption record("record", "Also record raw live chat responses into a fixture directory.", "Directory", "");
+        parser.addOption(record);
+
+        QCommandLineOption replay("replay", "Archive a live chat recorded with --record instead of the live one.", "Directory", "");
+        parser.addOption(replay);
+
+        parser.addHelpOption();
+        parser.process(a);
+
+        if (parser.isSet("record"))
+            HttpFixtures::startRecording(parser.value("record"));
+        else if (parser.isSet("replay"))
+            HttpFixtures::startReplaying(parser.value("replay"));
+
+        // replays are read straight from the fixture directory, everything else talks to InnerTube
+        if (!HttpFixtures::isReplaying())
+            QtTubeApplication::createInnerTubeClient();
+
+        const QString videoId = parser.value("archive-chat");
+        const QString logPath = parser.isSet("archive-file") ? parser.value("archive-file") : videoId + ".chat.jsonl";
+
+        ChatArchiver archiver(videoId, logPath);
+        QTimer::singleShot(0, &archiver, &ChatArchiver::run);
+        return a.exec();
+    }
+}
 
 int main(int argc, char *argv[])
 {
+    Benchmark::markLaunch();
     QApplication::setApplicationName(QTTUBE_APP_NAME);
     QApplication::setApplicationVersion(QTTUBE_VERSION_NAME);
 
+    // has to be decided before any application object exists, since this one mustn't be a QApplication
+    if (std::any_of(argv + 1, argv + argc, [](const char* arg) { return qstrncmp(arg, "--archive-chat", 14) == 0; }))
+        return runChatArchiver(argc, argv);
+
 #if QT_VERSION <= QT_VERSION_CHECK(6, 0, 0)
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
@@ -23,12 +79,33 @@ int main(int argc, char *argv[])
     QCommandLineParser parser;
     parser.setApplicationDescription(QTTUBE_APP_DESC);
 
+    QCommandLineOption benchmark("benchmark", "Time a load (home, trending, search:<query>, channel:<id>, video:<id>, player, chat:<rate=N,emoji=F,paid=F,members=F>, mousemove[:<count>], notify[:<count>]), print the results and exit.", "Scenario", "");
+    parser.addOption(benchmark);
+
     QCommandLineOption channel(QStringList() << "c" << "channel", "View a channel.", "Channel ID", "");
     parser.addOption(channel);
 
+    QCommandLineOption archiveChat("archive-chat", "Archive a live chat to a JSON Lines log without opening any windows. Takes --archive-file, --record and --replay.", "Video ID");
+    parser.addOption(archiveChat);
+
     QCommandLineOption chat("chat", "Open a live chat window.", "Video ID");
     parser.addOption(chat);
 
+    QCommandLineOption chatLog("chat-log", "Play back a log written by --archive-chat in a live chat window.", "File");
+    parser.addOption(chatLog);
+
+    QCommandLineOption record("record", "Record responses into a fixture directory. Covers images, third-party APIs and raw InnerTube requests (feeds, search, live metadata).", "Directory", "");
+    parser.addOption(record);
+
+    QCommandLineOption replay("replay", "Serve what --record covers from a fixture directory made with it, without the network. Channel and video page loads still go to InnerTube.", "Directory", "");
+    parser.addOption(replay);
+
+    QCommandLineOption suggestionsServer("suggestions-server", "Fetch search suggestions from another server (e.g. a local one for testing).", "URL", "");
+    parser.addOption(suggestionsServer);
+
+    QCommandLineOption trace("trace", "Write a Chrome trace of this session to a file.", "File", "");
+    parser.addOption(trace);
+
     QCommandLineOption version("version", "Displays version information.");
     parser.addOption(version);
 
@@ -43,12 +120,30 @@ int main(int argc, char *argv[])
         parser.showHelp();
     if (parser.isSet("version"))
         parser.showVersion();
+    if (parser.isSet("trace"))
+        Tracing::start(parser.value("trace"));
+    if (parser.isSet("suggestions-server"))
+        SearchSuggestions::instance()->setServerUrl(QUrl(parser.value("suggestions-server")));
+    if (parser.isSet("record"))
+        HttpFixtures::startRecording(parser.value("record"));
+    else if (parser.isSet("replay"))
+        HttpFixtures::startReplaying(parser.value("replay"));
+
+    if (parser.isSet("chat-log"))
+    {
+        qtTubeApp->doInitialSetup();
+
+        LiveChatWindow liveChatWindow;
+        liveChatWindow.show();
+        liveChatWindow.initializeArchive(parser.value("chat-log"));
+        return a.exec();
+    }
 
     if (parser.isSet("chat"))
     {
         qtTubeApp->doInitialSetup();
 
-        auto endpoint = InnerTube::instance()->getBlocking<InnertubeEndpoints::Next>(parser.value("chat"));
+        auto endpoint = NetworkMetrics::instance()->getBlocking<InnertubeEndpoints::Next>("Next", parser.value("chat"));
 
         if (const std::optional<InnertubeObjects::LiveChat>& conversationBar = endpoint.response.contents.conversationBar)
         {
@@ -67,6 +162,12 @@ int main(int argc, char *argv[])
     MainWindow w(parser);
     w.show();
 
+    if (parser.isSet("benchmark"))
+    {
+        Benchmark* benchmarkRunner = new Benchmark(parser.value("benchmark"), &w);
+        QTimer::singleShot(0, benchmarkRunner, &Benchmark::run);
+    }
+
 #ifdef QTTUBE_HAS_WAYLAND
     if (a.platformName() == "wayland")
         a.waylandInterface().initialize();
@@ -1,23 +1,33 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "eastereggs.h"
 #include "qttubeapplication.h"
 #include "stores/settingsstore.h"
 #include "ui/browsehelper.h"
-#include "ui/views/channelview.h"
+#include "ui/forms/networkmetricswindow.h"
+#include "ui/views/navigationhistory.h"
 #include "ui/views/viewcontroller.h"
-#include "ui/views/watchview.h"
 #include "ui/widgets/accountmenu/accountcontrollerwidget.h"
+#include "ui/widgets/webengineplayer/webengineplayer.h"
+#include "utils/networkmetrics.h"
+#include "utils/requestscheduler.h"
+#include "utils/searchsuggestions.h"
+#include "utils/tracing.h"
 #include "utils/uiutils.h"
 #include <QAction>
 #include <QComboBox>
 #include <QLineEdit>
 #include <QScrollBar>
+#include <QTimer>
 #include <QUrlQuery>
+#include <QWindow>
 
 MainWindow::~MainWindow() { delete ui; }
 
 MainWindow::MainWindow(const QCommandLineParser& parser, QWidget* parent) : QMainWindow(parent), ui(new Ui::MainWindow)
 {
+    Tracing::Span span("MainWindow::MainWindow", "startup");
+
     ui->setupUi(this);
     setWindowTitle(QTTUBE_APP_NAME);
 
@@ -30,12 +40,28 @@ MainWindow::MainWindow(const QCommandLineParser& parser, QWidget* parent) : QMai
     notificationMenu->setContinuationThreshold(5);
 
     findbar = new FindBar(this);
-    connect(ui->centralwidget, &QStackedWidget::currentChanged, this, [this] {
+    connect(ui->centralwidget, &QStackedWidget::currentChanged, this, [this](int index) {
         if (findbar->isVisible())
             findbar->setReveal(false);
+        // coming back from a channel or video is like coming back to the tab
+        if (index == 0 && ui->tabWidget->currentIndex() <= 3)
+            revalidateTab(ui->tabWidget->currentIndex());
     });
 
-    connect(m_topbar, &TopBar::signInStatusChanged, this, [this] { if (ui->centralwidget->currentIndex() == 0) browse(); });
+    connect(m_topbar, &TopBar::signInStatusChanged, this, [this] {
+        // feeds and notifications belong to whoever was signed in before
+        clearTabs();
+        notificationMenu->clear();
+        notificationsFetched.invalidate();
+        if (ui->centralwidget->currentIndex() == 0)
+            browse();
+    });
+    // something new came in, so the menu is out of date however recently it was fetched. it's only refetched
+    // once the bell is opened though, since fetching it is what marks notifications as seen.
+    connect(m_topbar, &TopBar::unseenCountChanged, this, [this](int count) {
+        if (count > 0)
+            notificationsFetched.invalidate();
+    });
     connect(m_topbar->avatarButton, &TubeLabel::clicked, this, &MainWindow::showAccountMenu);
     connect(m_topbar->notificationBell, &TopBarBell::clicked, this, &MainWindow::showNotifications);
     connect(m_topbar->searchBox, &SearchBox::searchRequested, this, &MainWindow::search);
@@ -55,8 +81,14 @@ MainWindow::MainWindow(const QCommandLineParser& parser, QWidget* parent) : QMai
         BrowseHelper::instance()->continuation<InnertubeEndpoints::BrowseHome>(ui->homeWidget);
     });
     connect(ui->searchWidget, &ContinuableListWidget::continuationReady, this, [this] {
-        BrowseHelper::instance()->continuation<InnertubeEndpoints::Search>(ui->searchWidget, lastSearchQuery);
+        BrowseHelper::instance()->continueSearch(ui->searchWidget);
     });
+
+    // combo boxes get flicked through, so only search once they've settled
+    filterSearchTimer = new QTimer(this);
+    filterSearchTimer->setInterval(FilterSearchDelay);
+    filterSearchTimer->setSingleShot(true);
+    connect(filterSearchTimer, &QTimer::timeout, this, &MainWindow::performFilteredSearch);
     connect(ui->subscriptionsWidget, &ContinuableListWidget::continuationReady, this, [this] {
         BrowseHelper::instance()->continuation<InnertubeEndpoints::BrowseSubscriptions>(ui->subscriptionsWidget);
     });
@@ -67,6 +99,16 @@ MainWindow::MainWindow(const QCommandLineParser& parser, QWidget* parent) : QMai
     connect(reloadShortcut, &QAction::triggered, this, &MainWindow::reloadCurrentTab);
     addAction(reloadShortcut);
 
+    QAction* backShortcut = new QAction(this);
+    backShortcut->setShortcuts(QKeySequence::Back);
+    connect(backShortcut, &QAction::triggered, NavigationHistory::instance(), &NavigationHistory::back);
+    addAction(backShortcut);
+
+    QAction* forwardShortcut = new QAction(this);
+    forwardShortcut->setShortcuts(QKeySequence::Forward);
+    connect(forwardShortcut, &QAction::triggered, NavigationHistory::instance(), &NavigationHistory::forward);
+    addAction(forwardShortcut);
+
     connect(InnerTube::instance()->authStore(), &InnertubeAuthStore::authenticateSuccess, this, [this] {
         m_topbar->postSignInSetup();
     });
@@ -83,6 +125,10 @@ MainWindow::MainWindow(const QCommandLineParser& parser, QWidget* parent) : QMai
     }
 #endif
 
+    // get a player warmed up once the event loop is idle so the first video doesn't pay for webengine startup
+    if (qtTubeApp->settings().externalPlayerPath.isEmpty())
+        QTimer::singleShot(0, this, [] { WebEnginePlayer::prewarm(); });
+
     if (parser.isSet("channel"))
         ViewController::loadChannel(parser.value("channel"));
     else if (parser.isSet("video"))
@@ -91,39 +137,67 @@ MainWindow::MainWindow(const QCommandLineParser& parser, QWidget* parent) : QMai
 
 void MainWindow::browse()
 {
-    if (doNotBrowse)
+    // the search tabs are filled by searching, and their filters live up top
+    const int index = ui->tabWidget->currentIndex();
+    if (doNotBrowse || index > 3)
         return;
 
     UIUtils::clearLayout(ui->additionalWidgets);
-    ui->historySearchWidget->clear();
-    ui->historyWidget->clear();
-    ui->homeWidget->clear();
-    ui->searchWidget->clear();
-    ui->subscriptionsWidget->clear();
-    ui->trendingWidget->clear();
-
-    switch (ui->tabWidget->currentIndex())
+    if (index == 3)
     {
-    case 0:
-        ui->homeWidget->toggleListGridLayout();
-        BrowseHelper::instance()->browseHome(ui->homeWidget);
-        break;
-    case 1:
-        BrowseHelper::instance()->browseTrending(ui->trendingWidget);
-        break;
-    case 2:
-        ui->subscriptionsWidget->toggleListGridLayout();
-        BrowseHelper::instance()->browseSubscriptions(ui->subscriptionsWidget);
-        break;
-    case 3:
         QLineEdit* historySearch = new QLineEdit(this);
         historySearch->setPlaceholderText("Search watch history");
         ui->additionalWidgets->addWidget(historySearch);
         connect(historySearch, &QLineEdit::returnPressed, this, &MainWindow::searchWatchHistory);
+    }
+
+    ContinuableListWidget* list = ui->tabWidget->widget(index)->findChild<ContinuableListWidget*>();
+    if (index == 0 || index == 2)
+        list->toggleListGridLayout();
+
+    // other tabs keep everything they've loaded, but images they're still waiting on can wait until they're back
+    RequestScheduler::instance()->setPriority(ui->tabWidget, RequestPriority::Deferred);
+    list->updateRequestPriorities();
 
-        BrowseHelper::instance()->browseHistory(ui->historyWidget);
-        break;
+    revalidateTab(index);
+}
+
+void MainWindow::clearTabs()
+{
+    RequestScheduler::instance()->cancel(ui->tabWidget);
+    for (int i = 0; i < int(tabsFetched.size()); ++i)
+    {
+        ui->tabWidget->widget(i)->findChild<ContinuableListWidget*>()->clear();
+        tabsFetched[i].invalidate();
+    }
+}
+
+// the window handle sees every key press and mouse move in the window before they're routed to a child widget,
+// so this replaces filtering on every event in the application.
+bool MainWindow::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == windowHandle())
+    {
+        switch (event->type())
+        {
+        case QEvent::KeyPress:
+            EasterEggs::checkEasterEggs(static_cast<QKeyEvent*>(event));
+            break;
+        case QEvent::MouseButtonPress:
+            if (static_cast<QMouseEvent*>(event)->button() == Qt::BackButton)
+                NavigationHistory::instance()->back();
+            else if (static_cast<QMouseEvent*>(event)->button() == Qt::ForwardButton)
+                NavigationHistory::instance()->forward();
+            break;
+        case QEvent::MouseMove:
+            if (qtTubeApp->settings().autoHideTopBar)
+                m_topbar->handleMouseMove(static_cast<QMouseEvent*>(event)->pos());
+            break;
+        default: break;
+        }
     }
+
+    return QMainWindow::eventFilter(watched, event);
 }
 
 void MainWindow::keyPressEvent(QKeyEvent* event)
@@ -131,12 +205,18 @@ void MainWindow::keyPressEvent(QKeyEvent* event)
     bool ctrlPressed = event->modifiers() & Qt::ControlModifier;
     if ((ctrlPressed && event->key() == Qt::Key_F) || (findbar->isVisible() && event->key() == Qt::Key_Escape))
         findbar->setReveal(findbar->isHidden());
+    else if (ctrlPressed && (event->modifiers() & Qt::ShiftModifier) && event->key() == Qt::Key_D)
+        NetworkMetricsWindow::toggle();
 
     QMainWindow::keyPressEvent(event);
 }
 
 void MainWindow::performFilteredSearch()
 {
+    // the filters are gone if search was left while the timer was running
+    if (ui->tabWidget->currentIndex() != 4)
+        return;
+
     ui->searchWidget->clear();
     int dateIndex = qobject_cast<QComboBox*>(ui->additionalWidgets->itemAt(1)->widget())->currentIndex();
     int typeIndex = qobject_cast<QComboBox*>(ui->additionalWidgets->itemAt(2)->widget())->currentIndex();
@@ -146,17 +226,29 @@ void MainWindow::performFilteredSearch()
     BrowseHelper::instance()->search(ui->searchWidget, lastSearchQuery, dateIndex, typeIndex, durIndex, featIndex, sortIndex);
 }
 
+void MainWindow::refreshNotifications()
+{
+    notificationsFetched.start();
+    BrowseHelper::instance()->browseNotificationMenu(notificationMenu);
+}
+
 void MainWindow::reloadCurrentTab()
 {
     if (ui->centralwidget->currentIndex() != 0 || !ui->tabWidget->isTabEnabled(ui->tabWidget->currentIndex()))
         return;
 
-    if (QWidget* widget = ui->tabWidget->widget(ui->tabWidget->currentIndex()))
-        if (ContinuableListWidget* list = widget->findChild<ContinuableListWidget*>(); list->isPopulating())
-            return;
+    ContinuableListWidget* list = ui->tabWidget->currentWidget()->findChild<ContinuableListWidget*>();
+    if (list->isPopulating())
+        return;
 
+    // a reload is asked for, so it starts over rather than waiting on a background refresh
     if (ui->tabWidget->currentIndex() <= 3)
-        browse();
+    {
+        RequestScheduler::instance()->cancel(list);
+        list->clear();
+        tabsFetched[ui->tabWidget->currentIndex()].invalidate();
+        revalidateTab(ui->tabWidget->currentIndex());
+    }
     else if (ui->tabWidget->currentIndex() == 4)
         performFilteredSearch();
     else if (ui->tabWidget->currentIndex() == 5)
@@ -186,6 +278,7 @@ void MainWindow::returnFromSearch()
     UIUtils::setTabsEnabled(ui->tabWidget, true, {0, 1, 2, 3});
     doNotBrowse = false;
     ui->tabWidget->setCurrentIndex(0);
+    RequestScheduler::instance()->cancel(ui->searchWidget);
     ui->searchWidget->clear();
 }
 
@@ -197,18 +290,44 @@ void MainWindow::returnFromWatchHistorySearch()
     UIUtils::setTabsEnabled(ui->tabWidget, true, {0, 1, 2, 3});
     doNotBrowse = false;
     ui->tabWidget->setCurrentIndex(3);
+    RequestScheduler::instance()->cancel(ui->historySearchWidget);
     ui->historySearchWidget->clear();
 }
 
+void MainWindow::revalidateTab(int index)
+{
+    ContinuableListWidget* list = ui->tabWidget->widget(index)->findChild<ContinuableListWidget*>();
+    QElapsedTimer& fetched = tabsFetched[index];
+    if (list->isPopulating())
+        return;
+    if (list->count() > 0 && fetched.isValid() && !fetched.hasExpired(qint64(qtTubeApp->settings().tabMaxAge) * 60000))
+        return;
+
+    // a list with something in it stays up while it's refreshed, see BrowseHelper
+    fetched.start();
+    switch (index)
+    {
+    case 0: BrowseHelper::instance()->browseHome(list); break;
+    case 1: BrowseHelper::instance()->browseTrending(list); break;
+    case 2: BrowseHelper::instance()->browseSubscriptions(list); break;
+    case 3: BrowseHelper::instance()->browseHistory(list); break;
+    }
+}
+
 void MainWindow::search(const QString& query, SearchBox::SearchType searchType)
 {
     if (query.isEmpty())
         return;
 
     if (searchType == SearchBox::SearchType::ByLink)
+    {
         searchByLink(query);
+    }
     else
+    {
+        SearchSuggestions::instance()->addToHistory(query);
         searchByQuery(query);
+    }
 }
 
 void MainWindow::searchByLink(const QString& link)
@@ -236,6 +355,7 @@ void MainWindow::searchByLink(const QString& link)
         using UrlEndpoint = InnertubeEndpoints::ResolveUrl;
         using UrlReply = InnertubeReply<UrlEndpoint>;
         auto reply = InnerTube::instance()->get<UrlEndpoint>(link);
+        NetworkMetrics::instance()->track(reply, "ResolveUrl");
         connect(reply, &UrlReply::exception, this, [this, link](const InnertubeException& ex) {
             QMessageBox::critical(this, "Error", ex.message());
         });
@@ -257,6 +377,7 @@ void MainWindow::searchByLink(const QString& link)
                 if (QString classicUrl = endpoint.endpoint["urlEndpoint"]["url"].toString(); !classicUrl.isEmpty())
                 {
                     auto reply2 = InnerTube::instance()->get<UrlEndpoint>(classicUrl);
+                    NetworkMetrics::instance()->track(reply2, "ResolveUrl");
                     connect(reply2, &UrlReply::finished, this, [](const UrlEndpoint& endpoint2) {
                         if (endpoint2.endpoint["commandMetadata"]["webCommandMetadata"]["webPageType"].toString() == "WEB_PAGE_TYPE_CHANNEL")
                             ViewController::loadChannel(endpoint2.endpoint["browseEndpoint"]["browseId"].toString());
@@ -274,13 +395,16 @@ void MainWindow::searchByLink(const QString& link)
 void MainWindow::searchByQuery(const QString& query)
 {
     m_topbar->setAlwaysShow(true);
+    // results are about to be replaced, and the other tabs keep what they've loaded but are about to be hidden
+    RequestScheduler::instance()->cancel(ui->searchWidget);
+    RequestScheduler::instance()->setPriority(ui->tabWidget, RequestPriority::Deferred);
+
     UIUtils::clearLayout(ui->additionalWidgets);
     ui->historySearchWidget->clear();
 
-    if (ChannelView* channelView = qobject_cast<ChannelView*>(ui->centralwidget->currentWidget()))
-        channelView->deleteLater();
-    else if (WatchView* watchView = qobject_cast<WatchView*>(ui->centralwidget->currentWidget()))
-        watchView->deleteLater();
+    // results go on the tabs, so whatever page is open is left for them
+    if (ui->centralwidget->currentIndex() != 0)
+        NavigationHistory::instance()->goHome();
 
     TubeLabel* filtersLabel = new TubeLabel("Filters:", this);
     ui->additionalWidgets->addWidget(filtersLabel);
@@ -327,11 +451,9 @@ void MainWindow::searchByQuery(const QString& query)
     lastSearchQuery = query;
     BrowseHelper::instance()->search(ui->searchWidget, lastSearchQuery);
 
-    connect(dateCmb, qOverload<int>(&QComboBox::currentIndexChanged), this, &MainWindow::performFilteredSearch);
-    connect(typeCmb, qOverload<int>(&QComboBox::currentIndexChanged), this, &MainWindow::performFilteredSearch);
-    connect(durCmb, qOverload<int>(&QComboBox::currentIndexChanged), this, &MainWindow::performFilteredSearch);
-    connect(featCmb, qOverload<int>(&QComboBox::currentIndexChanged), this, &MainWindow::performFilteredSearch);
-    connect(sortCmb, qOverload<int>(&QComboBox::currentIndexChanged), this, &MainWindow::performFilteredSearch);
+    filterSearchTimer->stop();
+    for (QComboBox* comboBox : { dateCmb, typeCmb, durCmb, featCmb, sortCmb })
+        connect(comboBox, qOverload<int>(&QComboBox::currentIndexChanged), filterSearchTimer, qOverload<>(&QTimer::start));
 }
 
 void MainWindow::searchWatchHistory()
@@ -355,6 +477,16 @@ void MainWindow::searchWatchHistory()
     BrowseHelper::instance()->browseHistory(ui->historySearchWidget, lastSearchQuery);
 }
 
+void MainWindow::showEvent(QShowEvent* event)
+{
+    // the window handle doesn't exist until the window is first shown.
+    // reinstalling on later shows is harmless, the filter is just moved to the front.
+    if (QWindow* handle = windowHandle())
+        handle->installEventFilter(this);
+
+    QMainWindow::showEvent(event);
+}
+
 void MainWindow::showAccountMenu()
 {
     if (AccountControllerWidget* accountController = findChild<AccountControllerWidget*>())
@@ -374,8 +506,13 @@ void MainWindow::showAccountMenu()
         accountController->move(m_topbar->avatarButton->x() - accountController->width() + 20, 35);
     });
 
+    if (const CredentialSet* activeLogin = qtTubeApp->creds().activeLogin())
+        accountController->accountMenu->initialize(*activeLogin);
+
     auto reply = InnerTube::instance()->get<InnertubeEndpoints::AccountMenu>();
-    connect(reply, &InnertubeReply<InnertubeEndpoints::AccountMenu>::finished, accountController->accountMenu, &AccountMenuWidget::initialize);
+    NetworkMetrics::instance()->track(reply, "AccountMenu");
+    connect(reply, &InnertubeReply<InnertubeEndpoints::AccountMenu>::finished, accountController->accountMenu,
+            qOverload<const InnertubeEndpoints::AccountMenu&>(&AccountMenuWidget::initialize));
 }
 
 void MainWindow::showNotifications()
@@ -383,12 +520,18 @@ void MainWindow::showNotifications()
     if (notificationMenu->isVisible())
     {
         m_topbar->setAlwaysShow(ui->centralwidget->currentIndex() == 0);
-        notificationMenu->clear();
         notificationMenu->hide();
         return;
     }
 
     m_topbar->setAlwaysShow(true);
     notificationMenu->show();
-    BrowseHelper::instance()->browseNotificationMenu(notificationMenu);
+    m_topbar->updateNotificationCount(0);
+
+    // whatever was loaded last time shows right away, and is revalidated behind it if it's gotten old
+    if (!notificationMenu->isPopulating() &&
+        (!notificationsFetched.isValid() || notificationsFetched.hasExpired(NotificationsMaxAge)))
+    {
+        refreshNotifications();
+    }
 }
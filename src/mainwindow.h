@@ -2,12 +2,16 @@
 #include "ui/widgets/continuablelistwidget.h"
 #include "ui/widgets/findbar.h"
 #include "ui/widgets/topbar/topbar.h"
+#include <array>
 #include <QCommandLineParser>
+#include <QElapsedTimer>
 #include <QKeyEvent>
 #include <QMainWindow>
 #include <QResizeEvent>
 #include <QStackedWidget>
 
+class QTimer;
+
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
@@ -16,6 +20,10 @@ class MainWindow : public QMainWindow
 {
     Q_OBJECT
 public:
+    static constexpr int FilterSearchDelay = 250;
+    // how long the notification menu is shown as-is before it's revalidated on open
+    static constexpr int NotificationsMaxAge = 60000;
+
     explicit MainWindow(const QCommandLineParser& parser, QWidget* parent = nullptr);
     ~MainWindow();
 
@@ -26,8 +34,10 @@ public slots:
     void showAccountMenu();
     void showNotifications();
 protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
     void keyPressEvent(QKeyEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
+    void showEvent(QShowEvent* event) override;
 private slots:
     void performFilteredSearch();
     void reloadCurrentTab();
@@ -37,6 +47,11 @@ private slots:
     void searchWatchHistory();
 private:
     void browse();
+    // drops what every tab has loaded, for when it no longer applies (like after switching accounts)
+    void clearTabs();
+    void refreshNotifications();
+    // loads the tab if it hasn't been, or refreshes it if it's been up longer than the max age from settings
+    void revalidateTab(int index);
     void searchByLink(const QString& link);
     void searchByQuery(const QString& query);
 
@@ -45,8 +60,11 @@ private:
     static inline TopBar* m_topbar;
 
     bool doNotBrowse = false;
+    QTimer* filterSearchTimer;
     FindBar* findbar;
     QString lastSearchQuery;
     ContinuableListWidget* notificationMenu;
+    QElapsedTimer notificationsFetched;
+    std::array<QElapsedTimer, 4> tabsFetched; // home, trending, subscriptions, history
     Ui::MainWindow* ui;
 };
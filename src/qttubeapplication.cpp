@@ -1,56 +1,53 @@
 #include "qttubeapplication.h"
-#include "eastereggs.h"
 #include "innertube.h"
-#include "localcache.h"
-#include "mainwindow.h"
+#include "utils/clientversions.h"
+#include "utils/tracing.h"
 #include "utils/uiutils.h"
+#include <QTimer>
+
+void QtTubeApplication::createInnerTubeClient()
+{
+    // start with whatever version is on hand so requests can go out right away,
+    // and switch over once the latest one has been looked up
+    const QString cver = ClientVersions::instance()->cached(InnertubeClient::ClientType::WEB);
+    InnerTube::instance()->createClient(InnertubeClient::ClientType::WEB, cver.isEmpty() ? QString(FallbackWebVersion) : cver);
+    if (cver.isEmpty())
+    {
+        ClientVersions::instance()->get(InnertubeClient::ClientType::WEB, nullptr, [](const QString& version) {
+            if (!version.isEmpty())
+                InnerTube::instance()->context()->client.clientVersion = version;
+        });
+    }
+}
 
 void QtTubeApplication::doInitialSetup()
 {
+    Tracing::Span span("QtTubeApplication::doInitialSetup", "startup");
+
     m_creds.initialize();
     m_settings.initialize();
 
     UIUtils::g_defaultStyle = style()->objectName();
     UIUtils::setAppStyle(m_settings.appStyle, m_settings.darkTheme);
 
-    LocalCache* cache = LocalCache::instance("client");
-    cache->setMaxSeconds(86400);
-
-    if (const QByteArray cver = cache->value("cver"); !cver.isNull())
-    {
-        InnerTube::instance()->createClient(InnertubeClient::ClientType::WEB, cver);
-    }
-    else
-    {
-        cache->clear();
-        InnerTube::instance()->createClient(InnertubeClient::ClientType::WEB, "2.20250421.01.00", true);
-        cache->insert("cver", InnerTube::instance()->context()->client.clientVersion.toLatin1());
-    }
+    createInnerTubeClient();
 
     if (const CredentialSet* activeLogin = m_creds.activeLogin())
-    {
         m_creds.populateAuthStore(*activeLogin);
-        if (InnerTube::instance()->hasAuthenticated())
-            emit InnerTube::instance()->authStore()->authenticateSuccess();
-    }
+
+    // everything past this point goes over the network (account, notifications, avatar),
+    // so it's left until the event loop is running and whoever called this has shown their window
+    QTimer::singleShot(0, this, &QtTubeApplication::doDeferredSetup);
 }
 
-bool QtTubeApplication::notify(QObject* receiver, QEvent* event)
+void QtTubeApplication::doDeferredSetup()
 {
-    if (receiver->objectName() == "MainWindowWindow")
-    {
-        switch (event->type())
-        {
-        case QEvent::KeyPress:
-            EasterEggs::checkEasterEggs(static_cast<QKeyEvent*>(event));
-            break;
-        case QEvent::MouseMove:
-            if (settings().autoHideTopBar)
-                MainWindow::topbar()->handleMouseEvent(static_cast<QMouseEvent*>(event));
-            break;
-        default: break;
-        }
-    }
+    Tracing::Span span("QtTubeApplication::doDeferredSetup", "startup");
 
-    return QApplication::notify(receiver, event);
+    // account and notification count requests go out in parallel from here (see TopBar::postSignInSetup).
+    // signed out, the only thing left to look up is the version the guest home feed needs.
+    if (InnerTube::instance()->hasAuthenticated())
+        emit InnerTube::instance()->authStore()->authenticateSuccess();
+    else
+        ClientVersions::instance()->prefetch(InnertubeClient::ClientType::IOS_UNPLUGGED);
 }
@@ -12,9 +12,15 @@
 class QtTubeApplication final : public QApplication
 {
 public:
+    // used until the latest web client version has been looked up, when there isn't one cached
+    static constexpr const char* FallbackWebVersion = "2.20250421.01.00";
+
     QtTubeApplication(int& argc, char** argv) : QApplication(argc, argv) {}
-    bool notify(QObject* receiver, QEvent* event) override;
 
+    // the part of setup that doesn't need a QtTubeApplication, for headless modes
+    static void createInnerTubeClient();
+    // loads what the window needs to show (credentials, settings, theme). network-bound setup
+    // is started in the background once the event loop is running.
     void doInitialSetup();
 
     CredentialsStore& creds() { return m_creds; }
@@ -30,4 +36,6 @@ private:
 #ifdef QTTUBE_HAS_WAYLAND
     WaylandInterface m_waylandInterface;
 #endif
+
+    void doDeferredSetup();
 };
@@ -12,6 +12,51 @@ const CredentialSet* CredentialsStore::activeLogin() const
     return it != m_credentials.end() ? &(*it) : nullptr;
 }
 
+void CredentialsStore::applyAccount(const QString& channelId, const QString& handle,
+                                    const QString& avatarUrl, const QString& username)
+{
+    if (auto active = std::ranges::find_if(m_credentials, &CredentialSet::active); active != m_credentials.end())
+    {
+        if (active->channelId != channelId)
+        {
+            active->active = false;
+            if (auto match = std::ranges::find(m_credentials, channelId, &CredentialSet::channelId); match != m_credentials.end())
+            {
+                match->active = true;
+                match->avatarUrl = avatarUrl;
+                match->handle = handle;
+                match->username = username;
+                save();
+                return;
+            }
+        }
+        else
+        {
+            active->avatarUrl = avatarUrl;
+            active->handle = handle;
+            active->username = username;
+            save();
+            return;
+        }
+    }
+
+    const InnertubeAuthStore* authStore = InnerTube::instance()->authStore();
+    m_credentials.append(CredentialSet {
+        .active = true,
+        .apisid = authStore->apisid,
+        .avatarUrl = avatarUrl,
+        .channelId = channelId,
+        .handle = handle,
+        .hsid = authStore->hsid,
+        .sapisid = authStore->sapisid,
+        .sid = authStore->sid,
+        .ssid = authStore->ssid,
+        .username = username,
+        .visitorInfo = authStore->visitorInfo
+    });
+    save();
+}
+
 void CredentialsStore::clear()
 {
     GenericStore::clear();
@@ -32,6 +77,7 @@ void CredentialsStore::initialize()
             .apisid = settings.value("apisid").toString(),
             .avatarUrl = settings.value("avatarUrl").toString(),
             .channelId = group,
+            .handle = settings.value("handle").toString(),
             .hsid = settings.value("hsid").toString(),
             .sapisid = settings.value("sapisid").toString(),
             .sid = settings.value("sid").toString(),
@@ -43,6 +89,12 @@ void CredentialsStore::initialize()
     }
 }
 
+void CredentialsStore::invalidLogin()
+{
+    QMessageBox::critical(nullptr, "Invalid Login Credentials", "Your login credentials are invalid. They may have expired. You will be logged out, then try logging in again.");
+    MainWindow::topbar()->signOut();
+}
+
 void CredentialsStore::populateAuthStore(const CredentialSet& credSet)
 {
     InnertubeAuthStore* authStore = InnerTube::instance()->authStore();
@@ -67,6 +119,7 @@ void CredentialsStore::save()
         settings.setValue("active", credSet.active);
         settings.setValue("apisid", credSet.apisid);
         settings.setValue("avatarUrl", credSet.avatarUrl);
+        settings.setValue("handle", credSet.handle);
         settings.setValue("hsid", credSet.hsid);
         settings.setValue("sapisid", credSet.sapisid);
         settings.setValue("sid", credSet.sid);
@@ -77,16 +130,19 @@ void CredentialsStore::save()
     }
 }
 
+void CredentialsStore::setActiveLogin(const QString& channelId)
+{
+    for (CredentialSet& credSet : m_credentials)
+        credSet.active = credSet.channelId == channelId;
+    save();
+}
+
 void CredentialsStore::updateAccount(const InnertubeEndpoints::AccountMenu& data)
 {
     const QString& channelHandle = data.response.header.channelHandle;
-    QString channelId;
-
-    if (channelHandle.isEmpty() ||
-        !(channelId = TubeUtils::getUcidFromUrl("https://www.youtube.com/" + channelHandle)).startsWith("UC"))
+    if (channelHandle.isEmpty())
     {
-        QMessageBox::critical(nullptr, "Invalid Login Credentials", "Your login credentials are invalid. They may have expired. You will be logged out, then try logging in again.");
-        MainWindow::topbar()->signOut();
+        invalidLogin();
         return;
     }
 
@@ -94,41 +150,27 @@ void CredentialsStore::updateAccount(const InnertubeEndpoints::AccountMenu& data
     QString avatarUrl = bestPhoto ? bestPhoto->url : QString();
     QString username = data.response.header.accountName;
 
-    if (auto active = std::ranges::find_if(m_credentials, &CredentialSet::active); active != m_credentials.end())
+    // handles rarely change, so a login seen before already has its channel ID stored with it
+    if (auto known = std::ranges::find(m_credentials, channelHandle, &CredentialSet::handle); known != m_credentials.end())
     {
-        if (active->channelId != channelId)
-        {
-            active->active = false;
-            if (auto match = std::ranges::find(m_credentials, channelId, &CredentialSet::channelId); match != m_credentials.end())
-            {
-                match->active = true;
-                match->avatarUrl = avatarUrl;
-                match->username = username;
-                save();
-                return;
-            }
-        }
-        else
+        const QString channelId = known->channelId;
+        applyAccount(channelId, channelHandle, avatarUrl, username);
+        return;
+    }
+
+    const QString sid = InnerTube::instance()->authStore()->sid;
+    TubeUtils::getUcidFromUrl("https://www.youtube.com/" + channelHandle).then(
+        [this, avatarUrl, channelHandle, sid, username](const QString& channelId) {
+        // whoever this was for has since signed out or switched accounts
+        if (InnerTube::instance()->authStore()->sid != sid)
+            return;
+
+        if (!channelId.startsWith("UC"))
         {
-            active->avatarUrl = avatarUrl;
-            active->username = username;
-            save();
+            invalidLogin();
             return;
         }
-    }
 
-    const InnertubeAuthStore* authStore = InnerTube::instance()->authStore();
-    m_credentials.append(CredentialSet {
-        .active = true,
-        .apisid = authStore->apisid,
-        .avatarUrl = avatarUrl,
-        .channelId = channelId,
-        .hsid = authStore->hsid,
-        .sapisid = authStore->sapisid,
-        .sid = authStore->sid,
-        .ssid = authStore->ssid,
-        .username = username,
-        .visitorInfo = authStore->visitorInfo
+        applyAccount(channelId, channelHandle, avatarUrl, username);
     });
-    save();
 }
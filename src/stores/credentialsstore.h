@@ -7,6 +7,7 @@ struct CredentialSet
     QString apisid;
     QString avatarUrl;
     QString channelId;
+    QString handle;
     QString hsid;
     QString sapisid;
     QString sid;
@@ -34,7 +35,13 @@ public:
     void save() override;
 
     void populateAuthStore(const CredentialSet& credSet);
+    void setActiveLogin(const QString& channelId);
+    // takes in the latest name, handle and avatar for the signed in account. the channel ID behind
+    // a handle is only looked up (asynchronously) when it isn't already known from a stored login.
     void updateAccount(const InnertubeEndpoints::AccountMenu& data);
 private:
     QList<CredentialSet> m_credentials;
+
+    void applyAccount(const QString& channelId, const QString& handle, const QString& avatarUrl, const QString& username);
+    void invalidLogin();
 };
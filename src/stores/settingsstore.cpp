@@ -24,8 +24,11 @@ void SettingsStore::initialize()
     downloadPath = settings.value("downloadPath").toString();
     fullSubs = settings.value("fullSubs", false).toBool();
     imageCaching = settings.value("imageCaching", true).toBool();
+    imagePrefetchScreens = settings.value("imagePrefetchScreens", 1).toInt();
     preferLists = settings.value("preferLists", false).toBool();
     returnDislikes = settings.value("returnDislikes", true).toBool();
+    tabMaxAge = settings.value("tabMaxAge", 10).toInt();
+    viewHistoryBudget = settings.value("viewHistoryBudget", 400).toInt();
     // player
     blockAds = settings.value("player/blockAds", true).toBool();
     disable60Fps = settings.value("player/disable60Fps", false).toBool();
@@ -40,6 +43,7 @@ void SettingsStore::initialize()
     volumeFromPlayer = settings.value("player/volumeFromPlayer", true).toBool();
     // privacy
     playbackTracking = settings.value("privacy/playbackTracking", true).toBool();
+    searchHistory = settings.value("privacy/searchHistory", true).toBool();
     watchtimeTracking = settings.value("privacy/watchtimeTracking", true).toBool();
     // filtering
     filterLength = settings.value("filtering/filterLength", 0).toInt();
@@ -83,8 +87,11 @@ void SettingsStore::save()
     settings.setValue("downloadPath", downloadPath);
     settings.setValue("fullSubs", fullSubs);
     settings.setValue("imageCaching", imageCaching);
+    settings.setValue("imagePrefetchScreens", imagePrefetchScreens);
     settings.setValue("preferLists", preferLists);
     settings.setValue("returnDislikes", returnDislikes);
+    settings.setValue("tabMaxAge", tabMaxAge);
+    settings.setValue("viewHistoryBudget", viewHistoryBudget);
     // player
     settings.setValue("player/blockAds", blockAds);
     settings.setValue("player/disable60Fps", disable60Fps);
@@ -99,6 +106,7 @@ void SettingsStore::save()
     settings.setValue("player/volumeFromPlayer", volumeFromPlayer);
     // privacy
     settings.setValue("privacy/playbackTracking", playbackTracking);
+    settings.setValue("privacy/searchHistory", searchHistory);
     settings.setValue("privacy/watchtimeTracking", watchtimeTracking);
     // filtering
     settings.setValue("filtering/filterLength", filterLength);
@@ -50,6 +50,7 @@ public:
     bool hideShorts{};
     bool hideStreams{};
     bool imageCaching{};
+    int imagePrefetchScreens{};
     bool playbackTracking{};
     bool preferLists{};
     PlayerQuality preferredQuality{};
@@ -57,9 +58,12 @@ public:
     bool qualityFromPlayer{};
     bool restoreAnnotations{};
     bool returnDislikes{};
+    bool searchHistory{};
     bool showSBToasts{};
     QStringList sponsorBlockCategories;
+    int tabMaxAge{}; // minutes
     bool vaapi{};
+    int viewHistoryBudget{}; // MB
     bool volumeFromPlayer{};
     bool watchtimeTracking{};
 
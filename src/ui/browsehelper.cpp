@@ -3,6 +3,10 @@
 #include "mainwindow.h"
 #include "protobuf/protobufcompiler.h"
 #include "qttubeapplication.h"
+#include "utils/clientversions.h"
+#include "utils/networkmetrics.h"
+#include "utils/searchcache.h"
+#include "utils/tracing.h"
 #include <ranges>
 
 using namespace InnertubeEndpoints;
@@ -19,7 +23,7 @@ void BrowseHelper::browseChannel(ContinuableListWidget* widget, int index, const
     if (!tabRenderer["selected"].toBool())
     {
         QString params = tabRenderer["endpoint"]["browseEndpoint"]["params"].toString();
-        auto bc = InnerTube::instance()->getBlocking<BrowseChannel>(resp.metadata.externalId, "", params);
+        auto bc = NetworkMetrics::instance()->getBlocking<BrowseChannel>("BrowseChannel", resp.metadata.externalId, "", params);
         tabRenderer = bc.response.contents["twoColumnBrowseResultsRenderer"]["tabs"][index]["tabRenderer"];
     }
 
@@ -51,24 +55,59 @@ void BrowseHelper::browseHistory(ContinuableListWidget* widget, const QString& q
 {
     if (!InnerTube::instance()->hasAuthenticated())
     {
+        widget->clear();
         widget->addItem("Local history has not been implemented yet. You will need to log in.");
         return;
     }
 
-    widget->setPopulatingFlag(true);
+    // a list that's already filled stays up while it's refreshed, like the snapshotted feeds.
+    // it's only merged into if nothing's been loaded past what was there.
+    const int shownRows = widget->count();
+    if (shownRows == 0)
+        widget->setPopulatingFlag(true);
+
+    quint64 traceId = Tracing::asyncBegin("BrowseHistory", "network");
     auto reply = InnerTube::instance()->get<BrowseHistory>(query);
-    connect(reply, &InnertubeReply<BrowseHistory>::exception, this,
-        std::bind_front(&BrowseHelper::browseFailed, this, "history", widget));
-    connect(reply, &InnertubeReply<BrowseHistory>::finished, this, [this, widget](const BrowseHistory& endpoint) {
+    NetworkMetrics::instance()->track(reply, "BrowseHistory");
+    connect(reply, &InnertubeReply<BrowseHistory>::exception, this, [this, shownRows, widget](const InnertubeException& ie) {
+        if (shownRows == 0)
+            browseFailed("history", widget, ie);
+        else
+            qWarning() << "Failed to refresh history:" << ie.message();
+    });
+    connect(reply, &InnertubeReply<BrowseHistory>::finished, this, [shownRows, widget, traceId](const BrowseHistory& endpoint) {
+        Tracing::asyncEnd("BrowseHistory", traceId, "network");
+
+        if (shownRows > 0)
+        {
+            if (widget->count() != shownRows || widget->isPopulating())
+                return;
+
+            // the old continuation token is still set while rows are merged in, so keep scrolling from using it
+            widget->setPopulatingFlag(true);
+            widget->setUpdatesEnabled(false);
+            widget->beginMerge();
+        }
+
         UIUtils::addRangeToList(widget, endpoint.response.videos);
         widget->continuationToken = endpoint.continuationToken;
+
+        if (shownRows > 0)
+        {
+            widget->endMerge();
+            widget->setUpdatesEnabled(true);
+        }
+
         widget->setPopulatingFlag(false);
     });
 }
 
 void BrowseHelper::browseHome(ContinuableListWidget* widget)
 {
-    widget->setPopulatingFlag(true);
+    auto setup = [this, widget](const BrowseHome& endpoint) {
+        setupHome(widget, endpoint.response);
+        widget->continuationToken = endpoint.continuationToken;
+    };
 
     // most clients will not serve you a home page unless if you are logged in or have searched for videos.
     // i don't like this. thankfully, there's a few clients that do still:
@@ -76,54 +115,69 @@ void BrowseHelper::browseHome(ContinuableListWidget* widget)
     // IOS_UNPLUGGED is the only one that works with tryCreate currently, so it will be used.
     if (InnerTube::instance()->hasAuthenticated())
     {
-        auto reply = InnerTube::instance()->get<BrowseHome>();
-        connect(reply, &InnertubeReply<BrowseHome>::exception, this,
-            std::bind_front(&BrowseHelper::browseFailed, this, "home", widget));
-        connect(reply, &InnertubeReply<BrowseHome>::finished, this, [this, widget](const BrowseHome& endpoint) {
-            setupHome(widget, endpoint.response);
-            widget->continuationToken = endpoint.continuationToken;
-            widget->setPopulatingFlag(false);
-        });
+        browseWithSnapshot<BrowseHome>(widget, "home", "BrowseHome", setup);
     }
     else
     {
-        auto reply = InnerTube::instance()->getRaw<BrowseHome>({
-            { "context", QJsonObject {
-                { "client", QJsonObject {
-                    { "clientName", static_cast<int>(InnertubeClient::ClientType::IOS_UNPLUGGED) },
-                    { "clientVersion", InnertubeClient::getLatestVersion(InnertubeClient::ClientType::IOS_UNPLUGGED) }
+        // the version is usually cached, or was already being looked up since startup
+        widget->setPopulatingFlag(true);
+        ClientVersions::instance()->get(InnertubeClient::ClientType::IOS_UNPLUGGED, widget,
+                                        [this, setup, widget](const QString& version) {
+            browseWithSnapshot<BrowseHome>(widget, "home", "BrowseHome", setup, QJsonObject {
+                { "context", QJsonObject {
+                    { "client", QJsonObject {
+                        { "clientName", static_cast<int>(InnertubeClient::ClientType::IOS_UNPLUGGED) },
+                        { "clientVersion", version }
+                    }}
                 }}
-            }}
-        });
-
-        connect(reply, &InnertubeReply<BrowseHome>::exception, this,
-            std::bind_front(&BrowseHelper::browseFailed, this, "home", widget));
-        connect(reply, &InnertubeReply<BrowseHome>::finishedRaw, this, [this, widget](const QJsonValue& data) {
-            if (const auto endpoint = InnerTube::tryCreate<BrowseHome>(data))
-            {
-                setupHome(widget, endpoint->response);
-                widget->continuationToken = endpoint->continuationToken;
-            }
-            else
-            {
-                browseFailed("home", widget, endpoint.error());
-            }
-
-            widget->setPopulatingFlag(false);
+            });
         });
     }
 }
 
 void BrowseHelper::browseNotificationMenu(ContinuableListWidget* widget)
 {
-    widget->setPopulatingFlag(true);
+    // a menu that's already filled stays up (and usable) while it's revalidated, then gets swapped out in one go,
+    // unless more has been loaded into it since
+    const int shownRows = widget->count();
+    const bool revalidating = shownRows > 0;
+
+    if (!revalidating)
+        widget->setPopulatingFlag(true);
+
+    quint64 traceId = Tracing::asyncBegin("GetNotificationMenu", "network");
     auto reply = InnerTube::instance()->get<GetNotificationMenu>("NOTIFICATIONS_MENU_REQUEST_TYPE_INBOX");
-    connect(reply, &InnertubeReply<GetNotificationMenu>::exception, this,
-        std::bind_front(&BrowseHelper::browseFailed, this, "notification", widget));
-    connect(reply, &InnertubeReply<GetNotificationMenu>::finished, this, [this, widget](const GetNotificationMenu& endpoint) {
+    NetworkMetrics::instance()->track(reply, "GetNotificationMenu");
+    connect(reply, &InnertubeReply<GetNotificationMenu>::exception, this, [this, revalidating, widget](const InnertubeException& ie) {
+        if (!revalidating)
+            return browseFailed("notification", widget, ie);
+        qWarning() << "Failed to refresh notifications:" << ie.message();
+    });
+    connect(reply, &InnertubeReply<GetNotificationMenu>::finished, this,
+            [revalidating, shownRows, widget, traceId](const GetNotificationMenu& endpoint) {
+        Tracing::asyncEnd("GetNotificationMenu", traceId, "network");
+
+        if (revalidating && (widget->count() != shownRows || widget->isPopulating()))
+            return;
+
+        const int scrollValue = widget->verticalScrollBar()->value();
+        if (revalidating)
+        {
+            widget->setPopulatingFlag(true);
+            widget->setUpdatesEnabled(false);
+            RequestScheduler::instance()->cancel(widget);
+            widget->clear();
+        }
+
         UIUtils::addRangeToList(widget, endpoint.response.notifications);
         widget->continuationToken = endpoint.continuationToken;
-        MainWindow::topbar()->updateNotificationCount(0);
+
+        if (revalidating)
+        {
+            widget->verticalScrollBar()->setValue(scrollValue);
+            widget->setUpdatesEnabled(true);
+        }
+
         widget->setPopulatingFlag(false);
     });
 }
@@ -132,31 +186,22 @@ void BrowseHelper::browseSubscriptions(ContinuableListWidget* widget)
 {
     if (!InnerTube::instance()->hasAuthenticated())
     {
+        widget->clear();
         widget->addItem("You need to log in to view subscriptions.");
         return;
     }
 
-    widget->setPopulatingFlag(true);
-    auto reply = InnerTube::instance()->get<BrowseSubscriptions>();
-    connect(reply, &InnertubeReply<BrowseSubscriptions>::exception, this,
-        std::bind_front(&BrowseHelper::browseFailed, this, "subscriptions", widget));
-    connect(reply, &InnertubeReply<BrowseSubscriptions>::finished, this, [this, widget](const BrowseSubscriptions& endpoint) {
+    browseWithSnapshot<BrowseSubscriptions>(widget, "subscriptions", "BrowseSubscriptions",
+                                            [widget](const BrowseSubscriptions& endpoint) {
         UIUtils::addRangeToList(widget, endpoint.response.videos);
         widget->continuationToken = endpoint.continuationToken;
-        widget->setPopulatingFlag(false);
     });
 }
 
 void BrowseHelper::browseTrending(ContinuableListWidget* widget)
 {
-    widget->setPopulatingFlag(true);
-    auto reply = InnerTube::instance()->get<BrowseTrending>();
-    connect(reply, &InnertubeReply<BrowseTrending>::exception, this,
-        std::bind_front(&BrowseHelper::browseFailed, this, "trending", widget));
-    connect(reply, &InnertubeReply<BrowseTrending>::finished, this, [this, widget](const BrowseTrending& endpoint) {
-        setupTrending(widget, endpoint.response);
-        widget->setPopulatingFlag(false);
-    });
+    browseWithSnapshot<BrowseTrending>(widget, "trending", "BrowseTrending",
+                                       [this, widget](const BrowseTrending& endpoint) { setupTrending(widget, endpoint.response); });
 }
 
 void BrowseHelper::continueChannel(ContinuableListWidget* widget, const QJsonValue& contents)
@@ -165,6 +210,17 @@ void BrowseHelper::continueChannel(ContinuableListWidget* widget, const QJsonVal
     ChannelBrowser::continuation(widget, contents);
 }
 
+void BrowseHelper::continueSearch(ContinuableListWidget* widget)
+{
+    if (widget->continuationToken.isEmpty() || widget->isPopulating())
+        return;
+
+    searchRequest(widget, widget->continuationToken, [this, widget](const Search& endpoint) {
+        setupSearch(widget, endpoint.response);
+        widget->continuationToken = endpoint.continuationToken;
+    });
+}
+
 void BrowseHelper::search(ContinuableListWidget* widget, const QString& query,
                           int dateF, int typeF, int durF, int featF, int sort)
 {
@@ -180,15 +236,12 @@ void BrowseHelper::search(ContinuableListWidget* widget, const QString& query,
     if (!params.isEmpty())
         compiledParams = ProtobufCompiler::compileEncoded(params, searchMsgFields);
 
-    widget->setPopulatingFlag(true);
-    auto reply = InnerTube::instance()->get<Search>(query, "", compiledParams);
-    connect(reply, &InnertubeReply<Search>::exception, this,
-        std::bind_front(&BrowseHelper::browseFailed, this, "search", widget));
-    connect(reply, &InnertubeReply<Search>::finished, this, [this, widget](const Search& endpoint) {
+    m_search = ActiveSearch { .generation = m_search.generation + 1, .params = compiledParams, .query = query };
+
+    searchRequest(widget, QString(), [this, widget](const Search& endpoint) {
         widget->addItem(QStringLiteral("About %1 results").arg(QLocale::system().toString(endpoint.response.estimatedResults)));
         setupSearch(widget, endpoint.response);
         widget->continuationToken = endpoint.continuationToken;
-        widget->setPopulatingFlag(false);
     });
 }
 
@@ -213,8 +266,60 @@ void BrowseHelper::removeTrailingSeparator(QListWidget* list)
 
 // TODO: make reel shelf widget, and expandable list widget, replace applicable code
 
+void BrowseHelper::searchRequest(ContinuableListWidget* widget, const QString& continuationToken,
+                                 const std::function<void(const Search&)>& setup)
+{
+    widget->setPopulatingFlag(true);
+
+    const QByteArray cacheKey = SearchCache::key(m_search.query, m_search.params, continuationToken);
+    auto finish = [setup, widget](const Search& endpoint) {
+        setup(endpoint);
+        widget->setPopulatingFlag(false);
+    };
+
+    if (const QJsonValue cached = SearchCache::instance()->value(cacheKey); !cached.isUndefined())
+    {
+        if (const auto endpoint = InnerTube::tryCreate<Search>(cached))
+        {
+            finish(endpoint.value());
+            return;
+        }
+    }
+
+    // a reply for a search that's since been replaced (new query, filters changed) would land in the wrong list
+    const quint64 generation = m_search.generation;
+    quint64 traceId = Tracing::asyncBegin("Search", "network");
+    // the same arguments get<Search>() and continuations have always used
+    auto reply = continuationToken.isEmpty()
+        ? HttpFixtures::getRaw<Search>("Search", m_search.query, QString(), m_search.params)
+        : HttpFixtures::getRaw<Search>("Search", QString(), continuationToken);
+    NetworkMetrics::instance()->track(reply, "Search");
+    connect(reply, &InnertubeReply<Search>::exception, this, [this, generation, widget](const InnertubeException& ie) {
+        if (generation == m_search.generation)
+            browseFailed("search", widget, ie);
+    });
+    connect(reply, &InnertubeReply<Search>::finishedRaw, this,
+            [this, cacheKey, finish, generation, traceId, widget](const QJsonValue& data) {
+        Tracing::asyncEnd("Search", traceId, "network");
+
+        const auto endpoint = InnerTube::tryCreate<Search>(data);
+        if (!endpoint)
+        {
+            if (generation == m_search.generation)
+                browseFailed("search", widget, endpoint.error());
+            return;
+        }
+
+        SearchCache::instance()->insert(cacheKey, data);
+        if (generation == m_search.generation)
+            finish(endpoint.value());
+    });
+}
+
 void BrowseHelper::setupHome(QListWidget* widget, const InnertubeEndpoints::HomeResponse& response)
 {
+    Tracing::Span span("BrowseHelper::setupHome", "render");
+
     // non-authenticated users will be under the IOS_UNPLUGGED client,
     // which serves thumbnails in an odd aspect ratio.
     bool useThumbnailFromData = InnerTube::instance()->hasAuthenticated();
@@ -285,6 +390,8 @@ void BrowseHelper::setupHome(QListWidget* widget, const InnertubeEndpoints::Home
 
 void BrowseHelper::setupSearch(QListWidget* widget, const InnertubeEndpoints::SearchResponse& response)
 {
+    Tracing::Span span("BrowseHelper::setupSearch", "render");
+
     for (const InnertubeEndpoints::SearchResponseItem& item : response.contents)
     {
         if (const auto* channel = std::get_if<InnertubeObjects::Channel>(&item))
@@ -323,6 +430,8 @@ void BrowseHelper::setupSearch(QListWidget* widget, const InnertubeEndpoints::Se
 
 void BrowseHelper::setupTrending(QListWidget* widget, const InnertubeEndpoints::TrendingResponse& response)
 {
+    Tracing::Span span("BrowseHelper::setupTrending", "render");
+
     for (const InnertubeEndpoints::TrendingResponseItem& item : response.contents)
     {
         if (const auto* horizontalShelf = std::get_if<InnertubeObjects::HorizontalVideoShelf>(&item))
@@ -1,5 +1,10 @@
 #pragma once
 #include "innertube.h"
+#include "utils/feedsnapshots.h"
+#include "utils/httpfixtures.h"
+#include "utils/networkmetrics.h"
+#include "utils/requestscheduler.h"
+#include "utils/tracing.h"
 #include "utils/uiutils.h"
 #include "ui/widgets/continuablelistwidget.h"
 #include <mutex>
@@ -20,6 +25,7 @@ public:
     void browseSubscriptions(ContinuableListWidget* widget);
     void browseTrending(ContinuableListWidget* widget);
     void continueChannel(ContinuableListWidget* widget, const QJsonValue& contents);
+    void continueSearch(ContinuableListWidget* widget);
     void search(ContinuableListWidget* widget, const QString& query,
                 int dateF = -1, int typeF = -1, int durF = -1, int featF = -1, int sort = -1);
 
@@ -59,19 +65,132 @@ public:
 private slots:
     void browseFailed(const QString& title, ContinuableListWidget* widget, const InnertubeException& ie);
 private:
+    struct ActiveSearch
+    {
+        quint64 generation{};
+        QByteArray params;
+        QString query;
+    };
+
     static inline BrowseHelper* m_instance;
     static inline std::once_flag m_onceFlag;
 
+    ActiveSearch m_search;
+
+    // paints the feed's snapshot from last time straight away (if there is one), then fetches the real thing.
+    // that's merged into the snapshot once it lands (see ContinuableListWidget::beginMerge()), unless the user
+    // has already loaded more past it, in which case it's only kept as the snapshot for next time. a list that
+    // already has the feed up is refreshed the same way, with what's there standing in for the snapshot.
+    // traceName has to be a literal, see Tracing.
+    // args are what the endpoint builds its request from, as with InnerTube::get().
+    template<EndpointWithData E, typename... Args>
+    void browseWithSnapshot(ContinuableListWidget* widget, const QString& feed, const char* traceName,
+                            const std::function<void(const E&)>& setup, const Args&... args)
+    {
+        int snapshotRows = -1;
+        if (widget->count() > 0)
+        {
+            snapshotRows = widget->count();
+            // the guest home feed sets this while it looks up its client version
+            widget->setPopulatingFlag(false);
+        }
+        else
+        {
+            widget->setPopulatingFlag(true);
+            if (const QJsonValue snapshot = FeedSnapshots::load(feed); !snapshot.isUndefined())
+            {
+                if (const auto endpoint = InnerTube::tryCreate<E>(snapshot))
+                {
+                    Tracing::Span span("BrowseHelper::paintSnapshot", "render");
+                    setup(endpoint.value());
+                    snapshotRows = widget->count();
+                    // the snapshot can be scrolled (and continued) while the fresh one loads
+                    widget->setPopulatingFlag(false);
+                }
+            }
+        }
+
+        // a stale feed beats an error box, so failures are only shown if there's nothing on screen
+        auto failed = [this, feed, snapshotRows, widget](const InnertubeException& ie) {
+            if (snapshotRows == -1)
+                browseFailed(feed, widget, ie);
+            else
+                qWarning().nospace() << "Failed to refresh " << feed << " snapshot: " << ie.message();
+        };
+
+        quint64 traceId = Tracing::asyncBegin(traceName, "network");
+        auto reply = HttpFixtures::getRaw<E>(traceName, args...);
+        NetworkMetrics::instance()->track(reply, traceName);
+        connect(reply, &InnertubeReply<E>::exception, this, failed);
+        connect(reply, &InnertubeReply<E>::finishedRaw, this,
+                [failed, feed, setup, snapshotRows, traceId, traceName, widget](const QJsonValue& data) {
+            Tracing::asyncEnd(traceName, traceId, "network");
+
+            const auto endpoint = [&data] {
+                Tracing::Span span("InnerTube::tryCreate", "parse");
+                return InnerTube::tryCreate<E>(data);
+            }();
+            if (!endpoint)
+            {
+                failed(endpoint.error());
+                return;
+            }
+
+            FeedSnapshots::save(feed, data);
+
+            if (snapshotRows == -1)
+            {
+                setup(endpoint.value());
+                widget->setPopulatingFlag(false);
+                return;
+            }
+
+            if (widget->count() != snapshotRows || widget->isPopulating())
+                return;
+
+            // merged with updates off so rows coming and going don't show up one by one
+            widget->setPopulatingFlag(true);
+            widget->setUpdatesEnabled(false);
+            widget->beginMerge();
+            setup(endpoint.value());
+            widget->endMerge();
+            widget->setUpdatesEnabled(true);
+            widget->setPopulatingFlag(false);
+        });
+    }
+
     template<EndpointWithData E>
     E browseRequest(const QString& continuationToken, const QString& data = "")
     {
+        Tracing::Span span("BrowseHelper::browseRequest", "network");
         if constexpr (innertube_is_any_v<E, InnertubeEndpoints::BrowseHome, InnertubeEndpoints::BrowseSubscriptions>)
-            return InnerTube::instance()->getBlocking<E>(continuationToken);
+            return NetworkMetrics::instance()->getBlocking<E>(continuationName<E>(), continuationToken);
+        else
+            return NetworkMetrics::instance()->getBlocking<E>(continuationName<E>(), data, continuationToken);
+    }
+
+    // continuations are recorded under the same name as the first page, so NetworkMetrics shows the feed as a whole
+    template<EndpointWithData E>
+    static constexpr const char* continuationName()
+    {
+        if constexpr (innertube_is_any_v<E, InnertubeEndpoints::BrowseChannel>)
+            return "BrowseChannel";
+        else if constexpr (innertube_is_any_v<E, InnertubeEndpoints::BrowseHistory>)
+            return "BrowseHistory";
+        else if constexpr (innertube_is_any_v<E, InnertubeEndpoints::BrowseHome>)
+            return "BrowseHome";
+        else if constexpr (innertube_is_any_v<E, InnertubeEndpoints::BrowseSubscriptions>)
+            return "BrowseSubscriptions";
+        else if constexpr (innertube_is_any_v<E, InnertubeEndpoints::GetNotificationMenu>)
+            return "GetNotificationMenu";
         else
-            return InnerTube::instance()->getBlocking<E>(data, continuationToken);
+            return "Continuation";
     }
 
     void removeTrailingSeparator(QListWidget* list);
+    // serves the page from SearchCache if it's there, otherwise fetches it (and caches it)
+    void searchRequest(ContinuableListWidget* widget, const QString& continuationToken,
+                       const std::function<void(const InnertubeEndpoints::Search&)>& setup);
     void setupHome(QListWidget* widget, const InnertubeEndpoints::HomeResponse& response);
     void setupSearch(QListWidget* widget, const InnertubeEndpoints::SearchResponse& response);
     void setupTrending(QListWidget* widget, const InnertubeEndpoints::TrendingResponse& response);
@@ -0,0 +1,197 @@
+#include "livechatloadgenerator.h"
+#include "innertube.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QTimer>
+#include <array>
+
+// argb colors of a few real super chat tiers: header background, body background
+constexpr std::array<std::pair<qint64, qint64>, 4> PaidTiers = {{
+    { 0xFF1565C0, 0xFF1E88E5 },
+    { 0xFF00B8D4, 0xFF00E5FF },
+    { 0xFFFFB300, 0xFFFFCA28 },
+    { 0xFFD00000, 0xFFE62117 }
+}};
+constexpr std::array<const char*, 12> Words = {
+    "lol", "hello", "first", "this", "is", "so", "good", "chat", "when", "the", "stream", "W"
+};
+
+LiveChatLoadGenerator::Options LiveChatLoadGenerator::Options::fromString(const QString& str)
+{
+    Options options;
+
+    const QStringList pairs = str.split(',', Qt::SkipEmptyParts);
+    for (const QString& pair : pairs)
+    {
+        const QString key = pair.section('=', 0, 0).trimmed();
+        const QString value = pair.section('=', 1).trimmed();
+
+        if (key == "emoji")
+            options.emojiDensity = std::clamp(value.toDouble(), 0.0, 1.0);
+        else if (key == "members")
+            options.membershipRatio = std::clamp(value.toDouble(), 0.0, 1.0);
+        else if (key == "paid")
+            options.paidRatio = std::clamp(value.toDouble(), 0.0, 1.0);
+        else if (key == "poll")
+            options.pollInterval = std::max(value.toInt(), 16);
+        else if (key == "rate")
+            options.messagesPerSecond = std::max(value.toInt(), 1);
+        else if (key == "seed")
+            options.seed = value.toUInt();
+    }
+
+    return options;
+}
+
+LiveChatLoadGenerator::LiveChatLoadGenerator(const Options& options, QObject* parent)
+    : QObject(parent), m_options(options), m_random(options.seed), m_timer(new QTimer(this))
+{
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &LiveChatLoadGenerator::tick);
+}
+
+QJsonObject LiveChatLoadGenerator::makeAuthor()
+{
+    // a small pool of authors so avatars hit the image cache like they would in a real chat
+    const int authorIndex = m_random.bounded(64);
+    const QString photoUrl = QStringLiteral("https://yt4.ggpht.com/synthetic/author%1=s64").arg(authorIndex % 16);
+
+    QJsonObject author {
+        { "authorExternalChannelId", QStringLiteral("UCsynthetic%1").arg(authorIndex) },
+        { "authorName", QJsonObject { { "simpleText", QStringLiteral("@synthetic%1").arg(authorIndex) } } },
+        { "authorPhoto", QJsonObject { { "thumbnails", QJsonArray {
+            QJsonObject { { "url", photoUrl }, { "width", 64 }, { "height", 64 } }
+        }}}},
+        { "id", QString::number(m_messagesGenerated) },
+        { "timestampUsec", QString::number(QDateTime::currentMSecsSinceEpoch() * 1000) }
+    };
+
+    if (authorIndex % 8 == 0)
+    {
+        author.insert("authorBadges", QJsonArray {
+            QJsonObject { { "liveChatAuthorBadgeRenderer", QJsonObject {
+                { "icon", QJsonObject { { "iconType", authorIndex == 0 ? "MODERATOR" : "MEMBER" } } }
+            }}}
+        });
+    }
+
+    return author;
+}
+
+QJsonObject LiveChatLoadGenerator::makeMembershipItem()
+{
+    QJsonObject renderer = makeAuthor();
+    renderer.insert("headerSubtext", QJsonObject { { "runs", QJsonArray {
+        QJsonObject { { "text", "Welcome to " } },
+        QJsonObject { { "text", "Synthetic Members" } },
+        QJsonObject { { "text", "!" } }
+    }}});
+    return QJsonObject { { "liveChatMembershipItemRenderer", renderer } };
+}
+
+QJsonObject LiveChatLoadGenerator::makeMessage()
+{
+    QJsonArray runs;
+
+    const int numWords = m_random.bounded(1, 13);
+    for (int i = 0; i < numWords; ++i)
+    {
+        if (roll(m_options.emojiDensity))
+        {
+            const int emojiIndex = m_random.bounded(24);
+            runs.append(QJsonObject { { "emoji", QJsonObject {
+                { "emojiId", QStringLiteral("synthetic/%1").arg(emojiIndex) },
+                { "image", QJsonObject { { "thumbnails", QJsonArray {
+                    QJsonObject { { "url", QStringLiteral("https://yt3.ggpht.com/synthetic/emoji%1=w24-h24").arg(emojiIndex) } }
+                }}}},
+                { "isCustomEmoji", true },
+                { "searchTerms", QJsonArray { QStringLiteral("synthetic%1").arg(emojiIndex) } },
+                { "shortcuts", QJsonArray { QStringLiteral(":synthetic%1:").arg(emojiIndex) } }
+            }}});
+        }
+        else
+        {
+            runs.append(QJsonObject { { "text", QString::fromLatin1(Words[m_random.bounded(int(Words.size()))]) + ' ' } });
+        }
+    }
+
+    return QJsonObject { { "runs", runs } };
+}
+
+QJsonObject LiveChatLoadGenerator::makePaidMessage()
+{
+    const auto& [headerColor, bodyColor] = PaidTiers[m_random.bounded(int(PaidTiers.size()))];
+
+    QJsonObject renderer = makeAuthor();
+    renderer.insert("bodyBackgroundColor", bodyColor);
+    renderer.insert("bodyTextColor", qint64(0xFFFFFFFF));
+    renderer.insert("headerBackgroundColor", headerColor);
+    renderer.insert("headerTextColor", qint64(0xFFFFFFFF));
+    renderer.insert("message", makeMessage());
+    renderer.insert("purchaseAmountText", QJsonObject {
+        { "simpleText", QStringLiteral("$%1.00").arg(m_random.bounded(1, 101)) }
+    });
+    return QJsonObject { { "liveChatPaidMessageRenderer", renderer } };
+}
+
+QJsonObject LiveChatLoadGenerator::makeTextMessage()
+{
+    QJsonObject renderer = makeAuthor();
+    renderer.insert("message", makeMessage());
+    return QJsonObject { { "liveChatTextMessageRenderer", renderer } };
+}
+
+bool LiveChatLoadGenerator::roll(double probability)
+{
+    return m_random.generateDouble() < probability;
+}
+
+void LiveChatLoadGenerator::start()
+{
+    m_timer->start(m_options.pollInterval);
+}
+
+void LiveChatLoadGenerator::stop()
+{
+    m_timer->stop();
+}
+
+void LiveChatLoadGenerator::tick()
+{
+    // carry the fractional part over so low rates with short poll intervals still add up
+    m_carry += m_options.messagesPerSecond * m_options.pollInterval / 1000.0;
+    const int count = static_cast<int>(m_carry);
+    m_carry -= count;
+
+    QJsonArray actions;
+    for (int i = 0; i < count; ++i)
+    {
+        QJsonObject item;
+        if (roll(m_options.paidRatio))
+            item = makePaidMessage();
+        else if (roll(m_options.membershipRatio))
+            item = makeMembershipItem();
+        else
+            item = makeTextMessage();
+
+        actions.append(QJsonObject { { "addChatItemAction", QJsonObject { { "item", item } } } });
+        ++m_messagesGenerated;
+    }
+
+    const QJsonObject response {
+        { "continuationContents", QJsonObject { { "liveChatContinuation", QJsonObject {
+            { "actions", actions },
+            { "continuations", QJsonArray {
+                QJsonObject { { "invalidationContinuationData", QJsonObject {
+                    { "continuation", "synthetic" },
+                    { "timeoutMs", m_options.pollInterval }
+                }}}
+            }}
+        }}}}
+    };
+
+    if (const auto endpoint = InnerTube::tryCreate<InnertubeEndpoints::GetLiveChat>(response))
+        emit responseReady(endpoint.value());
+    else
+        qWarning() << "Synthetic live chat response was rejected:" << endpoint.error().message();
+}
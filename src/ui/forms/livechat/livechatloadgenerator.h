@@ -0,0 +1,55 @@
+#pragma once
+#include <QJsonObject>
+#include <QObject>
+#include <QRandomGenerator>
+
+namespace InnertubeEndpoints
+{
+struct GetLiveChat;
+}
+
+class QTimer;
+
+// produces fake get_live_chat responses locally so the chat window can be pushed
+// harder than any real stream would, without touching the network.
+class LiveChatLoadGenerator : public QObject
+{
+    Q_OBJECT
+public:
+    struct Options
+    {
+        double emojiDensity = 0.1;
+        double membershipRatio = 0.005;
+        int messagesPerSecond = 200;
+        double paidRatio = 0.01;
+        int pollInterval = 1000;
+        quint32 seed = 1;
+
+        // parses "rate=500,emoji=0.3,paid=0.02,members=0.01,poll=1000,seed=1". unknown keys are ignored.
+        static Options fromString(const QString& str);
+    };
+
+    explicit LiveChatLoadGenerator(const Options& options, QObject* parent = nullptr);
+    qint64 messagesGenerated() const { return m_messagesGenerated; }
+    const Options& options() const { return m_options; }
+    void setMessagesPerSecond(int messagesPerSecond) { m_options.messagesPerSecond = messagesPerSecond; }
+    void start();
+    void stop();
+private:
+    double m_carry{};
+    qint64 m_messagesGenerated{};
+    Options m_options;
+    QRandomGenerator m_random;
+    QTimer* m_timer;
+
+    QJsonObject makeAuthor();
+    QJsonObject makeMembershipItem();
+    QJsonObject makeMessage();
+    QJsonObject makePaidMessage();
+    QJsonObject makeTextMessage();
+    bool roll(double probability);
+private slots:
+    void tick();
+signals:
+    void responseReady(const InnertubeEndpoints::GetLiveChat& liveChat);
+};
@@ -3,13 +3,20 @@
 #include "innertube.h"
 #include "ui/forms/emojimenu.h"
 #include "ui/widgets/labels/tubelabel.h"
+#include "utils/networkmetrics.h"
 #include "utils/uiutils.h"
 #include "ytemoji.h"
 #include "giftredemptionmessage.h"
+#include "livechatloadgenerator.h"
 #include "paidmessage.h"
 #include "specialmessage.h"
 #include "textmessage.h"
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QRandomGenerator>
 #include <QTimer>
+#include <QWindow>
 
 LiveChatWindow::LiveChatWindow(QWidget* parent)
     : QWidget(parent), emojiMenuLabel(new TubeLabel(this)), messagesTimer(new QTimer(this)), ui(new Ui::LiveChatWindow)
@@ -26,22 +33,33 @@ LiveChatWindow::LiveChatWindow(QWidget* parent)
     connect(ui->chatModeSwitcher, qOverload<int>(&QComboBox::currentIndexChanged), this, &LiveChatWindow::chatModeIndexChanged);
     connect(ui->messageBox, &QLineEdit::returnPressed, this, &LiveChatWindow::sendMessage);
     connect(ui->sendButton, &QPushButton::pressed, this, &LiveChatWindow::sendMessage);
+
+    // single shot, scheduleNextPoll() rearms it after every response
+    messagesTimer->setSingleShot(true);
+    connect(messagesTimer, &QTimer::timeout, this, &LiveChatWindow::chatTick);
 }
 
 void LiveChatWindow::addChatItemToList(const QJsonValue& item)
 {
+    QWidget* message{};
     if (const QJsonValue textMessage = item["liveChatTextMessageRenderer"]; textMessage.isObject()) [[likely]]
-        UIUtils::addWidgetToList(ui->listWidget, new TextMessage(textMessage, this));
+        message = new TextMessage(textMessage, this);
     else if (const QJsonValue membership = item["liveChatMembershipItemRenderer"]; membership.isObject())
-        UIUtils::addWidgetToList(ui->listWidget, new SpecialMessage(membership, this, "authorName", "headerSubtext", false, "#0f9d58"));
+        message = new SpecialMessage(membership, this, "authorName", "headerSubtext", false, "#0f9d58");
     else if (const QJsonValue modeChange = item["liveChatModeChangeMessageRenderer"]; modeChange.isObject())
-        UIUtils::addWidgetToList(ui->listWidget, new SpecialMessage(modeChange, this));
+        message = new SpecialMessage(modeChange, this);
     else if (const QJsonValue paidMessage = item["liveChatPaidMessageRenderer"]; paidMessage.isObject())
-        UIUtils::addWidgetToList(ui->listWidget, new PaidMessage(paidMessage, this));
+        message = new PaidMessage(paidMessage, this);
     else if (const QJsonValue giftRedemption = item["liveChatSponsorshipsGiftRedemptionAnnouncementRenderer"]; giftRedemption.isObject())
-        UIUtils::addWidgetToList(ui->listWidget, new GiftRedemptionMessage(giftRedemption, this));
+        message = new GiftRedemptionMessage(giftRedemption, this);
     else if (const QJsonValue engagement = item["liveChatViewerEngagementMessageRenderer"]; engagement.isObject())
-        UIUtils::addWidgetToList(ui->listWidget, new SpecialMessage(engagement, this, "text", "message", false));
+        message = new SpecialMessage(engagement, this, "text", "message", false);
+
+    if (!message)
+        return;
+
+    UIUtils::addWidgetToList(ui->listWidget, message);
+    ++numAddedMessages;
 }
 
 void LiveChatWindow::addNewChatReplayItems(double progress, double previousProgress, bool seeked)
@@ -62,6 +80,17 @@ void LiveChatWindow::addNewChatReplayItems(double progress, double previousProgr
     }
 }
 
+void LiveChatWindow::changeEvent(QEvent* event)
+{
+    QWidget::changeEvent(event);
+    if (event->type() == QEvent::WindowStateChange && !isMinimized() && pollBackoff > 0 && messagesTimer->isActive())
+    {
+        // coming back from being minimized, don't make the user wait out the backoff
+        pollBackoff = 0;
+        messagesTimer->start(0);
+    }
+}
+
 void LiveChatWindow::chatModeIndexChanged(int index)
 {
     QString continuation = index == 0 ? topChatReloadContinuation : liveChatReloadContinuation;
@@ -94,6 +123,7 @@ void LiveChatWindow::chatReplayTick(double progress, double previousProgress)
         ui->listWidget->clear();
         auto reply = InnerTube::instance()->get<InnertubeEndpoints::GetLiveChatReplay>(
             seekContinuation, QString::number(int(progress * 1000)));
+        NetworkMetrics::instance()->track(reply, "GetLiveChatReplay");
         connect(reply, &InnertubeReply<InnertubeEndpoints::GetLiveChatReplay>::finished, this,
                 std::bind_front(&LiveChatWindow::processChatReplayData, this, progress, previousProgress, true));
     }
@@ -101,6 +131,7 @@ void LiveChatWindow::chatReplayTick(double progress, double previousProgress)
     {
         auto reply = InnerTube::instance()->get<InnertubeEndpoints::GetLiveChatReplay>(
             currentContinuation, QString::number(int(progress * 1000)));
+        NetworkMetrics::instance()->track(reply, "GetLiveChatReplay");
         connect(reply, &InnertubeReply<InnertubeEndpoints::GetLiveChatReplay>::finished, this,
                 std::bind_front(&LiveChatWindow::processChatReplayData, this, progress, previousProgress, false));
     }
@@ -117,7 +148,13 @@ void LiveChatWindow::chatTick()
 
     populating = true;
     auto reply = InnerTube::instance()->get<InnertubeEndpoints::GetLiveChat>(currentContinuation);
+    NetworkMetrics::instance()->track(reply, "GetLiveChat");
     connect(reply, &InnertubeReply<InnertubeEndpoints::GetLiveChat>::finished, this, &LiveChatWindow::processChatData);
+    connect(reply, &InnertubeReply<InnertubeEndpoints::GetLiveChat>::exception, this, [this](const InnertubeException& ie) {
+        qWarning() << "Failed to get live chat:" << ie.message();
+        processingEnd();
+        scheduleNextPoll(true);
+    });
 }
 
 void LiveChatWindow::initialize(const QString& continuation, bool isReplay, WatchViewPlayer* player)
@@ -135,11 +172,57 @@ void LiveChatWindow::initialize(const QString& continuation, bool isReplay, Watc
     }
     else
     {
-        messagesTimer->start(1000);
-        connect(messagesTimer, &QTimer::timeout, this, &LiveChatWindow::chatTick);
+        polling = true;
+        messagesTimer->start(0);
     }
 }
 
+void LiveChatWindow::initializeArchive(const QString& path)
+{
+    emojiMenuLabel->hide();
+    ui->chatModeSwitcher->hide();
+    ui->messageBox->hide();
+    ui->sendButton->hide();
+
+    QFile* file = new QFile(path, this);
+    if (!file->open(QFile::ReadOnly))
+    {
+        qWarning() << "Failed to open chat log:" << file->errorString();
+        return;
+    }
+
+    // read a line ahead, a batch is every line that was received at the same time as the first
+    auto readLine = [file] { return QJsonDocument::fromJson(file->readLine()).object(); };
+    std::shared_ptr<QJsonObject> next = std::make_shared<QJsonObject>(readLine());
+
+    QTimer* playbackTimer = new QTimer(this);
+    playbackTimer->setSingleShot(true);
+    connect(playbackTimer, &QTimer::timeout, this, [this, next, playbackTimer, readLine] {
+        const qint64 batchTime = (*next)["receivedMs"].toVariant().toLongLong();
+        while (!next->isEmpty() && (*next)["receivedMs"].toVariant().toLongLong() == batchTime)
+        {
+            addChatItemToList((*next)["item"]);
+            *next = readLine();
+        }
+
+        processingEnd();
+
+        // gaps from reconnects can be minutes long, nobody wants to sit through those
+        if (!next->isEmpty())
+            playbackTimer->start(std::clamp<qint64>((*next)["receivedMs"].toVariant().toLongLong() - batchTime, 0, 5000));
+    });
+    playbackTimer->start(0);
+}
+
+void LiveChatWindow::initializeSynthetic(LiveChatLoadGenerator* generator)
+{
+    emojiMenuLabel->hide();
+    ui->chatModeSwitcher->hide();
+    ui->messageBox->hide();
+    ui->sendButton->hide();
+    connect(generator, &LiveChatLoadGenerator::responseReady, this, &LiveChatWindow::processChatData);
+}
+
 void LiveChatWindow::insertEmoji(const QString& emoji)
 {
     if (const QString msg = ui->messageBox->text(); !msg.isEmpty() && ui->messageBox->cursorPosition() == msg.size())
@@ -148,6 +231,13 @@ void LiveChatWindow::insertEmoji(const QString& emoji)
         ui->messageBox->insert(emoji);
 }
 
+bool LiveChatWindow::isChatHidden() const
+{
+    // QWindow stops being exposed when it's fully covered, at least on platforms that can tell
+    const QWindow* windowHandle = window()->windowHandle();
+    return !isVisible() || window()->isMinimized() || (windowHandle && !windowHandle->isExposed());
+}
+
 void LiveChatWindow::processChatData(const InnertubeEndpoints::GetLiveChat& liveChat)
 {
     // check if user can chat
@@ -178,19 +268,49 @@ void LiveChatWindow::processChatData(const InnertubeEndpoints::GetLiveChat& live
         liveChatReloadContinuation = sortFilter[1]["continuation"]["reloadContinuationData"]["continuation"].toString();
     }
 
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    int numMessages{};
+    qint64 totalMessageAge{};
+
     const QJsonArray actions = liveChat.liveChatContinuation["actions"].toArray();
     for (const QJsonValue& action : actions)
+    {
         if (const QJsonValue item = action["addChatItemAction"]["item"]; item.isObject())
+        {
             addChatItemToList(item);
 
+            // every renderer keeps its timestamp at the same spot, whatever kind it is
+            const QJsonObject renderer = item.toObject().constBegin().value().toObject();
+            if (const qint64 timestampUsec = renderer["timestampUsec"].toString().toLongLong(); timestampUsec > 0)
+            {
+                ++numMessages;
+                totalMessageAge += std::max<qint64>(now - timestampUsec / 1000, 0);
+            }
+        }
+    }
+
     const QJsonValue continuationObj = liveChat.liveChatContinuation["continuations"][0];
-    const QString continuation = continuationObj["invalidationContinuationData"]["continuation"].toString();
-    if (!continuation.isEmpty())
+    const QJsonValue continuationData = continuationObj["invalidationContinuationData"].isObject()
+        ? continuationObj["invalidationContinuationData"] : continuationObj["timedContinuationData"];
+    if (const QString continuation = continuationData["continuation"].toString(); !continuation.isEmpty())
+    {
         currentContinuation = continuation;
+        pollTimeout = continuationData["timeoutMs"].toInt(DefaultPollInterval);
+    }
     else if (continuationObj["reloadContinuationData"].isObject()) // should be true if live stream has finished
-        messagesTimer->stop();
+    {
+        polling = false;
+    }
 
     processingEnd();
+
+    if (polling)
+    {
+        // message age says how much latency the polling interval is costing, next to requests per hour
+        NetworkMetrics::instance()->recordItems("InnerTube GetLiveChat", numMessages, totalMessageAge);
+        // nobody's waiting on a chat that's hidden and quiet, so it can back off until either changes
+        scheduleNextPoll(actions.isEmpty() && isChatHidden());
+    }
 }
 
 void LiveChatWindow::processChatReplayData(double progress, double previousProgress, bool seeked,
@@ -223,6 +343,23 @@ void LiveChatWindow::processingEnd()
     emit getLiveChatFinished();
 }
 
+void LiveChatWindow::scheduleNextPoll(bool backOff)
+{
+    if (!polling)
+        return;
+
+    // each poll in a row that backs off doubles the interval, up to MaxPollInterval
+    // (or whatever the server asked for, if that's even longer)
+    pollBackoff = backOff ? pollBackoff + 1 : 0;
+
+    const qint64 backedOff = qint64(std::max(pollTimeout, 100)) << std::min(pollBackoff, 8);
+    const int interval = std::min(backedOff, qint64(std::max(pollTimeout, MaxPollInterval)));
+
+    // +/- 10% so that many clients on the same stream don't end up polling in lockstep
+    const int jitter = interval / 10;
+    messagesTimer->start(interval + QRandomGenerator::global()->bounded(-jitter, jitter + 1));
+}
+
 void LiveChatWindow::sendMessage()
 {
     if (ui->messageBox->text().trimmed().isEmpty())
@@ -240,6 +377,16 @@ void LiveChatWindow::sendMessage()
     ui->messageBox->clear();
 }
 
+void LiveChatWindow::showEvent(QShowEvent* event)
+{
+    QWidget::showEvent(event);
+    if (pollBackoff > 0 && messagesTimer->isActive())
+    {
+        pollBackoff = 0;
+        messagesTimer->start(0);
+    }
+}
+
 void LiveChatWindow::showEmojiMenu()
 {
     EmojiMenu* emojiMenu = new EmojiMenu;
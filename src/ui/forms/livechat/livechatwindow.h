@@ -13,6 +13,7 @@ struct GetLiveChat;
 struct GetLiveChatReplay;
 }
 
+class LiveChatLoadGenerator;
 class QJsonArray;
 class QTimer;
 class TubeLabel;
@@ -23,16 +24,33 @@ class LiveChatWindow : public QWidget
 public:
     explicit LiveChatWindow(QWidget* parent = nullptr);
     ~LiveChatWindow();
+    // messages that have made it into the list so far, for measuring throughput
+    qint64 messagesAdded() const { return numAddedMessages; }
 public slots:
     void initialize(const QString& continuation, bool isReplay, WatchViewPlayer* player);
+    // plays back a log written by ChatArchiver at the pace it was recorded in
+    void initializeArchive(const QString& path);
+    void initializeSynthetic(LiveChatLoadGenerator* generator);
+protected:
+    void changeEvent(QEvent* event) override;
+    void showEvent(QShowEvent* event) override;
 private:
+    // used when the server doesn't give a timeout
+    static constexpr int DefaultPollInterval = 1000;
+    // how far polling can back off while the chat is hidden and quiet, or erroring
+    static constexpr int MaxPollInterval = 30000;
+
     QJsonValue actionPanel;
     QString currentContinuation;
     double firstChatItemOffset{};
     double lastChatItemOffset{};
     QString liveChatReloadContinuation;
     QTimer* messagesTimer;
+    qint64 numAddedMessages{};
     int numSentMessages{};
+    int pollBackoff{};
+    bool polling{};
+    int pollTimeout = DefaultPollInterval;
     bool populating{};
     QJsonArray replayActions;
     QString seekContinuation;
@@ -43,7 +61,9 @@ private:
 
     void addChatItemToList(const QJsonValue& item);
     void addNewChatReplayItems(double progress, double previousProgress, bool seeked);
+    bool isChatHidden() const;
     void processingEnd();
+    void scheduleNextPoll(bool backOff);
     void updateChatReplay(double progress, double previousProgress);
 private slots:
     void chatModeIndexChanged(int index);
@@ -50,7 +50,7 @@ PaidMessage::PaidMessage(const QJsonValue& renderer, QWidget* parent)
     headerLayout->addWidget(authorIcon);
     headerLayout->addSpacerItem(new QSpacerItem(6, 0));
 
-    HttpReply* iconReply = HttpUtils::cachedInstance().get(renderer["authorPhoto"]["thumbnails"][0]["url"].toString());
+    HttpReply* iconReply = HttpUtils::get(renderer["authorPhoto"]["thumbnails"][0]["url"].toString(), true);
     connect(iconReply, &HttpReply::finished, this, &PaidMessage::setAuthorIcon);
 
     innerHeaderLayout->setContentsMargins(0, 0, 0, 0);
@@ -77,10 +77,7 @@ PaidMessage::PaidMessage(const QJsonValue& renderer, QWidget* parent)
     messageLabel->setWordWrap(true);
     layout->addWidget(messageLabel);
 
-    InnertubeStringFormatter* fmt = new InnertubeStringFormatter;
-    connect(fmt, &InnertubeStringFormatter::finished, fmt, &InnertubeStringFormatter::deleteLater);
-    connect(fmt, &InnertubeStringFormatter::readyRead, messageLabel, &TubeLabel::setText);
-    fmt->setData(message, false);
+    InnertubeStringFormatter::setLabelText(messageLabel, message, false);
 }
 
 void PaidMessage::setAuthorIcon(const HttpReply& reply)
@@ -28,7 +28,7 @@ TextMessage::TextMessage(const QJsonValue& renderer, QWidget* parent)
     InnertubeObjects::ResponsiveImage authorPhoto(renderer["authorPhoto"]["thumbnails"]);
     if (const InnertubeObjects::GenericThumbnail* bestPhoto = authorPhoto.bestQuality())
     {
-        HttpReply* iconReply = HttpUtils::cachedInstance().get(bestPhoto->url);
+        HttpReply* iconReply = HttpUtils::get(bestPhoto->url, true);
         connect(iconReply, &HttpReply::finished, this, &TextMessage::setAuthorIcon);
     }
 
@@ -77,10 +77,7 @@ TextMessage::TextMessage(const QJsonValue& renderer, QWidget* parent)
     contentLayout->addWidget(messageLabel);
 
     InnertubeObjects::InnertubeString message(renderer["message"]);
-    InnertubeStringFormatter* fmt = new InnertubeStringFormatter;
-    connect(fmt, &InnertubeStringFormatter::finished, fmt, &InnertubeStringFormatter::deleteLater);
-    connect(fmt, &InnertubeStringFormatter::readyRead, messageLabel, &TubeLabel::setText);
-    fmt->setData(message, false);
+    InnertubeStringFormatter::setLabelText(messageLabel, message, false);
 }
 
 void TextMessage::setAuthorIcon(const HttpReply& reply)
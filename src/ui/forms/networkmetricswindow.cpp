@@ -0,0 +1,120 @@
+#include "networkmetricswindow.h"
+#include "utils/networkmetrics.h"
+#include "utils/stringutils.h"
+#include <QBoxLayout>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QJsonDocument>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTimer>
+
+NetworkMetricsWindow::NetworkMetricsWindow(QWidget* parent)
+    : QWidget(parent),
+      m_exportButton(new QPushButton("Export JSON", this)),
+      m_refreshTimer(new QTimer(this)),
+      m_resetButton(new QPushButton("Reset", this)),
+      m_table(new QTableWidget(this))
+{
+    setAttribute(Qt::WA_DeleteOnClose);
+    setWindowFlag(Qt::Tool);
+    setWindowTitle("Network Metrics");
+    resize(900, 400);
+
+    m_table->setColumnCount(15);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setHorizontalHeaderLabels({
+        "Endpoint", "Requests", "Req/h", "Coalesced", "Errors", "Cache Hit %", "Bytes", "Skipped", "Saved (est.)",
+        "Mean", "p50", "p95", "Max", "Error %", "Item Age"
+    });
+    m_table->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_table->verticalHeader()->hide();
+
+    QHBoxLayout* buttonLayout = new QHBoxLayout;
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(m_resetButton);
+    buttonLayout->addWidget(m_exportButton);
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->addWidget(m_table);
+    layout->addLayout(buttonLayout);
+
+    // requests can finish in bursts of hundreds, so don't rebuild the table for every single one
+    m_refreshTimer->setInterval(500);
+    m_refreshTimer->setSingleShot(true);
+
+    connect(m_exportButton, &QPushButton::clicked, this, &NetworkMetricsWindow::exportJson);
+    connect(m_refreshTimer, &QTimer::timeout, this, &NetworkMetricsWindow::refresh);
+    connect(m_resetButton, &QPushButton::clicked, NetworkMetrics::instance(), &NetworkMetrics::reset);
+    connect(NetworkMetrics::instance(), &NetworkMetrics::updated, this, [this] {
+        if (!m_refreshTimer->isActive())
+            m_refreshTimer->start();
+    });
+
+    refresh();
+}
+
+void NetworkMetricsWindow::exportJson()
+{
+    const QString path = QFileDialog::getSaveFileName(this, "Export network metrics", "network-metrics.json", "JSON (*.json)");
+    if (path.isEmpty())
+        return;
+
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate))
+    {
+        QMessageBox::critical(this, "Failed to export", file.errorString());
+        return;
+    }
+
+    file.write(QJsonDocument(NetworkMetrics::instance()->toJson()).toJson());
+}
+
+void NetworkMetricsWindow::refresh()
+{
+    auto numericItem = [](const QString& text) {
+        QTableWidgetItem* item = new QTableWidgetItem(text);
+        item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        return item;
+    };
+    auto msItem = [&numericItem](qint64 ms) { return numericItem(QString::number(ms) + " ms"); };
+    auto percentItem = [&numericItem](double ratio) { return numericItem(QString::number(ratio * 100, 'f', 1) + '%'); };
+
+    m_table->setRowCount(0);
+
+    const QMap<QString, NetworkMetrics::EndpointStats>& endpoints = NetworkMetrics::instance()->endpoints();
+    for (auto it = endpoints.cbegin(); it != endpoints.cend(); ++it)
+    {
+        const NetworkMetrics::EndpointStats& stats = it.value();
+        const int row = m_table->rowCount();
+        m_table->insertRow(row);
+        m_table->setItem(row, 0, new QTableWidgetItem(it.key()));
+        m_table->setItem(row, 1, numericItem(QString::number(stats.requests)));
+        m_table->setItem(row, 2, numericItem(QString::number(NetworkMetrics::instance()->requestsPerHour(stats), 'f', 0)));
+        m_table->setItem(row, 3, numericItem(QString::number(stats.coalesced)));
+        m_table->setItem(row, 4, numericItem(QString::number(stats.errors)));
+        m_table->setItem(row, 5, percentItem(stats.cacheHitRatio()));
+        m_table->setItem(row, 6, numericItem(StringUtils::bytesString(stats.bytes)));
+        m_table->setItem(row, 7, numericItem(QString::number(stats.skipped)));
+        m_table->setItem(row, 8, numericItem(StringUtils::bytesString(stats.bytesSaved())));
+        m_table->setItem(row, 9, msItem(stats.meanLatency()));
+        m_table->setItem(row, 10, msItem(stats.latencyPercentile(0.5)));
+        m_table->setItem(row, 11, msItem(stats.latencyPercentile(0.95)));
+        m_table->setItem(row, 12, msItem(stats.maxLatency));
+        m_table->setItem(row, 13, percentItem(stats.errorRate()));
+        m_table->setItem(row, 14, stats.items > 0 ? msItem(stats.meanItemLatency()) : numericItem("-"));
+    }
+}
+
+void NetworkMetricsWindow::toggle()
+{
+    if (m_instance)
+    {
+        m_instance->close();
+        return;
+    }
+
+    m_instance = new NetworkMetricsWindow;
+    m_instance->show();
+}
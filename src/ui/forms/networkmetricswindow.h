@@ -0,0 +1,25 @@
+#pragma once
+#include <QPointer>
+#include <QWidget>
+
+class QPushButton;
+class QTableWidget;
+class QTimer;
+
+class NetworkMetricsWindow : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit NetworkMetricsWindow(QWidget* parent = nullptr);
+    static void toggle();
+private:
+    static inline QPointer<NetworkMetricsWindow> m_instance;
+
+    QPushButton* m_exportButton;
+    QTimer* m_refreshTimer;
+    QPushButton* m_resetButton;
+    QTableWidget* m_table;
+private slots:
+    void exportJson();
+    void refresh();
+};
@@ -2,6 +2,7 @@
 #include "ui_channelfiltertable.h"
 #include "innertube.h"
 #include "qttubeapplication.h"
+#include "utils/networkmetrics.h"
 #include <QMessageBox>
 
 ChannelFilterTable::~ChannelFilterTable() { delete ui; }
@@ -114,5 +115,5 @@ void ChannelFilterTable::validateItemInput(QTableWidgetItem* item)
         return;
     }
 
-    processChannelEntry(InnerTube::instance()->getBlocking<InnertubeEndpoints::BrowseChannel>(item->text()), item);
+    processChannelEntry(NetworkMetrics::instance()->getBlocking<InnertubeEndpoints::BrowseChannel>("BrowseChannel", item->text()), item);
 }
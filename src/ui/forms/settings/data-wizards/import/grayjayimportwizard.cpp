@@ -2,6 +2,7 @@
 #include "innertube.h"
 #include "shared/choosesubspage.h"
 #include "shared/choosewatchhistorypage.h"
+#include "utils/networkmetrics.h"
 #include <QCheckBox>
 #include <QFile>
 #include <QJsonArray>
@@ -65,7 +66,7 @@ void GrayjayImportSubsPage::trySub(const QString& channelId)
     {
         try
         {
-            auto endpoint = InnerTube::instance()->getBlocking<InnertubeEndpoints::BrowseChannel>(channelId);
+            auto endpoint = NetworkMetrics::instance()->getBlocking<InnertubeEndpoints::BrowseChannel>("BrowseChannel", channelId);
             if (auto c4 = std::get_if<InnertubeObjects::ChannelC4Header>(&endpoint.response.header))
                 subs.append(Entity(channelId, c4->title));
             else if (auto page = std::get_if<InnertubeObjects::ChannelPageHeader>(&endpoint.response.header))
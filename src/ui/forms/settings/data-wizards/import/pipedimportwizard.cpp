@@ -2,6 +2,7 @@
 #include "innertube.h"
 #include "shared/choosesubspage.h"
 #include "shared/choosewatchhistorypage.h"
+#include "utils/networkmetrics.h"
 #include <QCheckBox>
 #include <QFile>
 #include <QJsonArray>
@@ -102,7 +103,7 @@ void PipedImportWatchHistoryPage::tryWatch(const QString& videoId)
     {
         try
         {
-            auto endpoint = InnerTube::instance()->getBlocking<InnertubeEndpoints::Player>(videoId);
+            auto endpoint = NetworkMetrics::instance()->getBlocking<InnertubeEndpoints::Player>("Player", videoId);
             QString name = QStringLiteral("<a href=\"%1\">%2</a> by <a href=\"%3\">%4</a>").arg(
                 "https://www.youtube.com/watch?v=" + videoId,
                 endpoint.response.videoDetails.title,
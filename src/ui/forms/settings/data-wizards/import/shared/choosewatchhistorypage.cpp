@@ -1,5 +1,6 @@
 #include "choosewatchhistorypage.h"
 #include "innertube.h"
+#include "utils/networkmetrics.h"
 #include "utils/tubeutils.h"
 #include <QDebug>
 
@@ -19,7 +20,7 @@ void ChooseWatchHistoryPage::addToWatchHistoryInThread(const Entity& video)
         {
             try
             {
-                auto player = InnerTube::instance()->getBlocking<InnertubeEndpoints::Player>(video.id);
+                auto player = NetworkMetrics::instance()->getBlocking<InnertubeEndpoints::Player>("Player", video.id);
                 TubeUtils::reportPlayback(player.response);
                 // prevent rate limit (apparently it exists but i didn't hit it.. better safe than sorry)
                 QThread::sleep(1);
@@ -9,12 +9,15 @@
 #include "qttubeapplication.h"
 #include "termfilterview.h"
 #include "ui/widgets/download/downloadmanager.h"
+#include "ui/widgets/webengineplayer/webengineplayer.h"
+#include "utils/searchsuggestions.h"
 #include "utils/stringutils.h"
 #include "utils/uiutils.h"
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QStandardPaths>
 #include <QStyleFactory>
+#include <QWebEngineProfile>
 
 constexpr QLatin1String DescriptionTemplate(R"(
 %1<br>
@@ -59,8 +62,11 @@ SettingsForm::SettingsForm(QWidget* parent) : QWidget(parent), ui(new Ui::Settin
     ui->downloadPathEdit->setText(store.downloadPath);
     ui->fullSubs->setChecked(store.fullSubs);
     ui->imageCaching->setChecked(store.imageCaching);
+    ui->imagePrefetchScreens->setValue(store.imagePrefetchScreens);
     ui->preferLists->setChecked(store.preferLists);
     ui->returnDislikes->setChecked(store.returnDislikes);
+    ui->tabMaxAge->setValue(store.tabMaxAge);
+    ui->viewHistoryBudget->setValue(store.viewHistoryBudget);
     // player
     ui->blockAds->setChecked(store.blockAds);
     ui->disable60Fps->setChecked(store.disable60Fps);
@@ -75,9 +81,12 @@ SettingsForm::SettingsForm(QWidget* parent) : QWidget(parent), ui(new Ui::Settin
     ui->restoreAnnotations->setChecked(store.restoreAnnotations);
     ui->vaapi->setChecked(store.vaapi);
     ui->volumeFromPlayer->setChecked(store.volumeFromPlayer);
+    ui->playerCacheStats->setText(QStringLiteral("%1 served from cache this session")
+        .arg(StringUtils::bytesString(WebEnginePlayer::cacheBytesServed())));
     toggleWebPlayerSettings(store.externalPlayerPath.isEmpty());
     // privacy
     ui->playbackTracking->setChecked(store.playbackTracking);
+    ui->searchHistory->setChecked(store.searchHistory);
     ui->watchtimeTracking->setChecked(store.watchtimeTracking);
     // filtering
     ui->filterLength->setEnabled(store.filterLengthEnabled);
@@ -103,6 +112,8 @@ SettingsForm::SettingsForm(QWidget* parent) : QWidget(parent), ui(new Ui::Settin
     toggleDeArrowSettings(store.deArrow);
 
     connect(ui->clearCache, &QPushButton::clicked, this, &SettingsForm::clearCache);
+    connect(ui->clearPlayerCache, &QPushButton::clicked, this, &SettingsForm::clearPlayerCache);
+    connect(ui->clearSearchHistory, &QPushButton::clicked, this, &SettingsForm::clearSearchHistory);
     connect(ui->deArrow, &QCheckBox::toggled, this, &SettingsForm::toggleDeArrowSettings);
     connect(ui->downloadPathButton, &QPushButton::clicked, this, &SettingsForm::selectDownloadPath);
     connect(ui->downloadPathEdit, &QLineEdit::textEdited, this, &SettingsForm::checkDownloadPath);
@@ -182,6 +193,18 @@ void SettingsForm::clearCache()
     QMessageBox::information(this, "Cleared", "Cache directory cleared successfully.");
 }
 
+void SettingsForm::clearPlayerCache()
+{
+    WebEnginePlayer::profile()->clearHttpCache();
+    QMessageBox::information(this, "Cleared", "Player cache cleared successfully.");
+}
+
+void SettingsForm::clearSearchHistory()
+{
+    SearchSuggestions::instance()->clearHistory();
+    QMessageBox::information(this, "Cleared", "Search history cleared successfully.");
+}
+
 void SettingsForm::closeEvent(QCloseEvent* event)
 {
     if (ui->saveButton->isEnabled())
@@ -287,8 +310,11 @@ void SettingsForm::saveSettings()
     store.downloadPath = ui->downloadPathEdit->text();
     store.fullSubs = ui->fullSubs->isChecked();
     store.imageCaching = ui->imageCaching->isChecked();
+    store.imagePrefetchScreens = ui->imagePrefetchScreens->value();
     store.preferLists = ui->preferLists->isChecked();
     store.returnDislikes = ui->returnDislikes->isChecked();
+    store.tabMaxAge = ui->tabMaxAge->value();
+    store.viewHistoryBudget = ui->viewHistoryBudget->value();
     // player
     store.blockAds = ui->blockAds->isChecked();
     store.disable60Fps = ui->disable60Fps->isChecked();
@@ -303,6 +329,7 @@ void SettingsForm::saveSettings()
     store.volumeFromPlayer = ui->volumeFromPlayer->isChecked();
     // privacy
     store.playbackTracking = ui->playbackTracking->isChecked();
+    store.searchHistory = ui->searchHistory->isChecked();
     store.watchtimeTracking = ui->watchtimeTracking->isChecked();
     // filtering
     store.filterLength = ui->filterLength->value();
@@ -380,6 +407,7 @@ void SettingsForm::toggleDeArrowSettings(bool checked)
 void SettingsForm::toggleWebPlayerSettings(bool checked)
 {
     ui->blockAds->setEnabled(checked);
+    ui->clearPlayerCache->setEnabled(checked);
     ui->disable60Fps->setEnabled(checked);
     ui->disablePlayerInfoPanels->setEnabled(checked);
     ui->h264Only->setEnabled(checked);
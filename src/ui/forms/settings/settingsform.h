@@ -23,6 +23,8 @@ private slots:
     void checkDownloadPath(const QString& text);
     void checkExternalPlayer(const QString& text);
     void clearCache();
+    void clearPlayerCache();
+    void clearSearchHistory();
     void enableSaveButton();
     //void openExportWizard();
     void openImportWizard();
@@ -1,16 +1,20 @@
 #include "channelview.h"
-#include "http.h"
 #include "mainwindow.h"
 #include "qttubeapplication.h"
 #include "ui/browsehelper.h"
 #include "ui/widgets/subscribe/subscribewidget.h"
+#include "utils/httputils.h"
+#include "utils/networkmetrics.h"
 #include <QBoxLayout>
 #include <QScrollBar>
 #include <ranges>
 
 ChannelView::~ChannelView()
 {
-    disconnect(MainWindow::topbar()->logo, &TubeLabel::clicked, this, nullptr);
+    // views evicted from navigation history are offscreen, and shouldn't touch whatever's showing now
+    if (!isVisible())
+        return;
+
     if (QMainWindow* mainWindow = UIUtils::getMainWindow())
         mainWindow->setWindowTitle(QTTUBE_APP_NAME);
 }
@@ -71,20 +75,15 @@ ChannelView::ChannelView(const QString& channelId)
     loadChannel(channelId);
 }
 
-void ChannelView::hotLoadChannel(const QString& channelId)
+int ChannelView::currentTab() const
 {
-    if (this->channelId == channelId)
-        return;
-
-    disconnect(channelTabs, &QTabWidget::currentChanged, nullptr, nullptr);
-    channelTabs->clear();
-    loadChannel(channelId);
+    return channelTabs->currentIndex();
 }
 
 void ChannelView::loadChannel(const QString& channelId)
 {
     this->channelId = channelId;
-    auto response = InnerTube::instance()->getBlocking<InnertubeEndpoints::BrowseChannel>(channelId).response;
+    auto response = NetworkMetrics::instance()->getBlocking<InnertubeEndpoints::BrowseChannel>("BrowseChannel", channelId).response;
 
     if (auto c4 = std::get_if<InnertubeObjects::ChannelC4Header>(&response.header))
         prepareHeader(*c4);
@@ -144,13 +143,13 @@ void ChannelView::prepareAvatarAndBanner(const InnertubeObjects::ResponsiveImage
 
     if (const InnertubeObjects::GenericThumbnail* recAvatar = avatar.recommendedQuality(QSize(48, 48)))
     {
-        HttpReply* iconReply = Http::instance().get(recAvatar->url);
+        HttpReply* iconReply = HttpUtils::get(recAvatar->url);
         connect(iconReply, &HttpReply::finished, this, &ChannelView::setIcon);
     }
 
     if (const InnertubeObjects::GenericThumbnail* bestBanner = banner.bestQuality())
     {
-        HttpReply* bannerReply = Http::instance().get(bestBanner->url);
+        HttpReply* bannerReply = HttpUtils::get(bestBanner->url);
         connect(bannerReply, &HttpReply::finished, this, &ChannelView::setBanner);
     }
 }
@@ -210,6 +209,12 @@ void ChannelView::setBanner(const HttpReply& reply)
     channelBanner->setPixmap(pixmap);
 }
 
+void ChannelView::setCurrentTab(int index)
+{
+    if (index > 0 && index < channelTabs->count())
+        channelTabs->setCurrentIndex(index);
+}
+
 void ChannelView::setIcon(const HttpReply& reply)
 {
     QPixmap pixmap;
@@ -25,7 +25,8 @@ class ChannelView : public QWidget
 public:
     explicit ChannelView(const QString& channelId);
     ~ChannelView();
-    void hotLoadChannel(const QString& channelId);
+    int currentTab() const;
+    void setCurrentTab(int index);
 private:
     QLabel* channelBanner;
     QWidget* channelHeaderContainer;
@@ -0,0 +1,249 @@
+#include "navigationhistory.h"
+#include "channelview.h"
+#include "mainwindow.h"
+#include "qttubeapplication.h"
+#include "ui/widgets/findbar.h"
+#include "ui/widgets/renderers/video/videothumbnailwidget.h"
+#include "ui/widgets/webengineplayer/webengineplayer.h"
+#include "utils/requestscheduler.h"
+#include "utils/uiutils.h"
+#include "viewcontroller.h"
+#include "watchview.h"
+#include <QRegularExpression>
+
+NavigationHistory* NavigationHistory::instance()
+{
+    std::call_once(m_onceFlag, [] { m_instance = new NavigationHistory; });
+    return m_instance;
+}
+
+NavigationHistory::NavigationHistory(QObject* parent) : QObject(parent)
+{
+    // views are only ever opened through here, so the tabs are what's showing before anything has been
+    m_entries.append(Entry { .kind = Kind::Tabs });
+    connect(MainWindow::topbar()->logo, &TubeLabel::clicked, this, &NavigationHistory::goHome);
+}
+
+void NavigationHistory::add(Entry&& entry)
+{
+    for (auto it = m_entries.begin() + m_index + 1; it != m_entries.end(); ++it)
+        if (it->view)
+            it->view->deleteLater();
+    m_entries.erase(m_entries.begin() + m_index + 1, m_entries.end());
+
+    m_entries.append(std::move(entry));
+    if (m_entries.size() > MaxEntries)
+    {
+        if (m_entries.first().view)
+            m_entries.first().view->deleteLater();
+        m_entries.removeFirst();
+    }
+
+    m_index = m_entries.size() - 1;
+}
+
+void NavigationHistory::back()
+{
+    if (canGoBack())
+        go(m_index - 1);
+}
+
+void NavigationHistory::discard(QWidget* view)
+{
+    view->deleteLater();
+
+    auto it = std::find_if(m_entries.begin(), m_entries.end(), [view](const Entry& entry) { return entry.view == view; });
+    if (it == m_entries.end())
+        return;
+
+    const int index = std::distance(m_entries.begin(), it);
+    m_entries.erase(it);
+
+    if (index < m_index)
+        --m_index;
+    else if (index == m_index)
+        show(index - 1);
+}
+
+void NavigationHistory::enforceBudget()
+{
+    const qint64 budget = qint64(qtTubeApp->settings().viewHistoryBudget) * 1024 * 1024;
+
+    qint64 used{};
+    for (int i = 0; i < m_entries.size(); ++i)
+        if (i != m_index && m_entries[i].view)
+            used += estimateCost(m_entries[i].view);
+
+    // the furthest pages are the least likely to be gone back to. on a tie, forward goes first,
+    // since going back is much more common.
+    while (used > budget)
+    {
+        int furthest = -1;
+        for (int i = 0; i < m_entries.size(); ++i)
+            if (i != m_index && m_entries[i].view && (furthest == -1 || std::abs(i - m_index) >= std::abs(furthest - m_index)))
+                furthest = i;
+
+        if (furthest == -1)
+            break;
+
+        QWidget* view = m_entries[furthest].view;
+        used -= estimateCost(view);
+        view->deleteLater();
+        m_entries[furthest].view.clear();
+    }
+}
+
+qint64 NavigationHistory::estimateCost(QWidget* view)
+{
+    qint64 cost = view->findChildren<QWidget*>().size() * WidgetCost;
+    if (view->findChild<WebEnginePlayer*>())
+        cost += PlayerCost;
+    return cost;
+}
+
+void NavigationHistory::forward()
+{
+    if (canGoForward())
+        go(m_index + 1);
+}
+
+void NavigationHistory::go(int index)
+{
+    remember(m_entries[m_index]);
+    suspend(m_entries[m_index]);
+    show(index);
+    enforceBudget();
+}
+
+void NavigationHistory::goHome()
+{
+    if (m_entries[m_index].kind == Kind::Tabs)
+        return;
+
+    remember(m_entries[m_index]);
+    suspend(m_entries[m_index]);
+    add(Entry { .kind = Kind::Tabs });
+    show(m_index);
+    enforceBudget();
+}
+
+void NavigationHistory::open(Kind kind, const QString& id, const std::function<QWidget*()>& create)
+{
+    if (const Entry& current = m_entries[m_index]; current.kind == kind && current.id == id && current.view)
+        return;
+
+    // the new view sets the title and top bar up for itself as it's built, so what's there now has to be saved first
+    const int previous = m_index;
+    remember(m_entries[previous]);
+
+    QWidget* view = create();
+    if (!view)
+    {
+        show(previous);
+        return;
+    }
+
+    suspend(m_entries[previous]);
+    add(Entry { .kind = kind, .id = id, .view = view });
+    MainWindow::centralWidget()->setCurrentWidget(view);
+    enforceBudget();
+}
+
+bool NavigationHistory::rebuild(Entry& entry)
+{
+    if (entry.kind == Kind::Channel)
+    {
+        if (ChannelView* channelView = ViewController::createChannelView(entry.id))
+        {
+            channelView->setCurrentTab(entry.tab);
+            entry.view = channelView;
+        }
+    }
+    else if (entry.kind == Kind::Video)
+    {
+        WatchView* watchView = ViewController::createWatchView(entry.id, entry.progress);
+        watchView->restoreScrollPosition(entry.scroll);
+        entry.view = watchView;
+    }
+
+    return !entry.view.isNull();
+}
+
+void NavigationHistory::remember(Entry& entry)
+{
+    // the player is about to be paused, so don't come back claiming it's playing
+    static QRegularExpression playingRegex(R"( \[Playing\]$)");
+
+    if (QMainWindow* mainWindow = UIUtils::getMainWindow())
+        entry.title = mainWindow->windowTitle().replace(playingRegex, " [Paused]");
+    entry.topBarAlwaysShown = MainWindow::topbar()->isAlwaysShown();
+
+    if (ChannelView* channelView = qobject_cast<ChannelView*>(entry.view))
+    {
+        entry.tab = channelView->currentTab();
+    }
+    else if (WatchView* watchView = qobject_cast<WatchView*>(entry.view))
+    {
+        entry.progress = watchView->progress();
+        entry.scroll = watchView->scrollPosition();
+    }
+}
+
+void NavigationHistory::show(int index)
+{
+    if (m_entries.isEmpty())
+        m_entries.append(Entry { .kind = Kind::Tabs });
+
+    m_index = std::clamp(index, 0, static_cast<int>(m_entries.size()) - 1);
+    Entry& entry = m_entries[m_index];
+
+    if (entry.kind == Kind::Tabs)
+    {
+        MainWindow::centralWidget()->setCurrentIndex(0);
+        MainWindow::topbar()->setAlwaysShow(true);
+        MainWindow::topbar()->show();
+        if (QMainWindow* mainWindow = UIUtils::getMainWindow())
+            mainWindow->setWindowTitle(QTTUBE_APP_NAME);
+        return;
+    }
+
+    if (!entry.view && !rebuild(entry))
+    {
+        // it's already said why it couldn't be loaded again
+        m_entries.removeAt(m_index);
+        show(m_index - 1);
+        return;
+    }
+
+    MainWindow::centralWidget()->setCurrentWidget(entry.view);
+    MainWindow::topbar()->setAlwaysShow(entry.topBarAlwaysShown);
+    MainWindow::topbar()->setVisible(entry.topBarAlwaysShown);
+    if (QMainWindow* mainWindow = UIUtils::getMainWindow(); mainWindow && !entry.title.isEmpty())
+        mainWindow->setWindowTitle(entry.title);
+
+    // whatever the view was still waiting on was held back when it was left.
+    // lists then put their offscreen items back to where they should be.
+    RequestScheduler::instance()->setPriority(entry.view, RequestPriority::Visible);
+    const QList<ContinuableListWidget*> lists = entry.view->findChildren<ContinuableListWidget*>();
+    for (ContinuableListWidget* list : lists)
+        list->updateRequestPriorities();
+    FindBar::indexListsWithin(entry.view);
+
+    if (WatchView* watchView = qobject_cast<WatchView*>(entry.view))
+        watchView->resume();
+}
+
+void NavigationHistory::suspend(Entry& entry)
+{
+    if (!entry.view)
+        return;
+
+    if (WatchView* watchView = qobject_cast<WatchView*>(entry.view))
+        watchView->suspend();
+
+    FindBar::dropListsWithin(entry.view);
+    RequestScheduler::instance()->setPriority(entry.view, RequestPriority::Deferred);
+    const QList<VideoThumbnailWidget*> thumbnails = entry.view->findChildren<VideoThumbnailWidget*>();
+    for (VideoThumbnailWidget* thumbnail : thumbnails)
+        thumbnail->releasePixmap();
+}
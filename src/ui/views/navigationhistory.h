@@ -0,0 +1,67 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <QObject>
+#include <QPointer>
+
+// pages that have been opened, for going back and forward through. views that are left are kept suspended
+// (players paused, thumbnails dropped) so going back to them is instant and lands where they were scrolled to,
+// as long as they fit in the memory budget from settings. past that, the views furthest from the current page
+// are deleted and only what's needed to rebuild them is kept.
+class NavigationHistory : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Kind { Tabs, Channel, Video };
+
+    static constexpr int MaxEntries = 100;
+    // rough estimates for the budget. with thumbnails dropped, a suspended view is mostly its widgets,
+    // unless it has an embedded player, which keeps a whole renderer process around.
+    static constexpr qint64 PlayerCost = 150 * 1024 * 1024;
+    static constexpr qint64 WidgetCost = 4 * 1024;
+
+    static NavigationHistory* instance();
+    explicit NavigationHistory(QObject* parent = nullptr);
+
+    bool canGoBack() const { return m_index > 0; }
+    bool canGoForward() const { return m_index < m_entries.size() - 1; }
+    // drops a view that failed to load. if it's the one showing, whatever was before it comes back.
+    void discard(QWidget* view);
+    // opens a page after the current one, dropping anything that could have been gone forward to.
+    // create should add the view to the central widget, or return nullptr if it couldn't be loaded.
+    void open(Kind kind, const QString& id, const std::function<QWidget*()>& create);
+public slots:
+    void back();
+    void forward();
+    // back to the tabs, which counts as a page of its own
+    void goHome();
+private:
+    struct Entry
+    {
+        Kind kind;
+        QString id;
+        // everything below is updated whenever the entry is left, so it can be rebuilt if its view is evicted
+        int progress{}; // seconds, videos only
+        int scroll{}; // videos only
+        int tab{}; // channels only
+        QString title;
+        bool topBarAlwaysShown = true;
+        QPointer<QWidget> view;
+    };
+
+    static inline NavigationHistory* m_instance;
+    static inline std::once_flag m_onceFlag;
+
+    QList<Entry> m_entries;
+    int m_index{};
+
+    static qint64 estimateCost(QWidget* view);
+
+    void add(Entry&& entry);
+    void enforceBudget();
+    void go(int index);
+    bool rebuild(Entry& entry);
+    void remember(Entry& entry);
+    void show(int index);
+    void suspend(Entry& entry);
+};
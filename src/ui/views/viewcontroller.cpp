@@ -2,82 +2,52 @@
 #include "channelview.h"
 #include "innertube/innertubeexception.h"
 #include "mainwindow.h"
+#include "navigationhistory.h"
 #include "watchview.h"
 #include <QMessageBox>
 
 namespace ViewController
 {
-    void loadChannel(const QString& channelId)
+    ChannelView* createChannelView(const QString& channelId)
     {
-        if (ChannelView* casted = qobject_cast<ChannelView*>(MainWindow::centralWidget()->currentWidget()))
-        {
-            try
-            {
-                casted->hotLoadChannel(channelId);
-            }
-            catch (InnertubeException& ie)
-            {
-                QMessageBox::critical(nullptr, "Failed to load channel", ie.message());
-            }
-
-            return;
-        }
-        else if (WatchView* watchView = qobject_cast<WatchView*>(MainWindow::centralWidget()->currentWidget()))
-        {
-            watchView->deleteLater();
-        }
-
-        ChannelView* channelView = nullptr;
         try
         {
-            channelView = new ChannelView(channelId);
+            ChannelView* channelView = new ChannelView(channelId);
+            MainWindow::centralWidget()->addWidget(channelView);
+            return channelView;
         }
         catch (InnertubeException& ie)
         {
             QMessageBox::critical(nullptr, "Failed to load channel", ie.message());
-            if (channelView)
-            {
-                channelView->deleteLater();
-                MainWindow::topbar()->setAlwaysShow(true);
-            }
+            return nullptr;
         }
-
-        MainWindow::centralWidget()->addWidget(channelView);
-        MainWindow::centralWidget()->setCurrentWidget(channelView);
-        QObject::connect(MainWindow::topbar()->logo, &TubeLabel::clicked, channelView, [channelView]
-        {
-            channelView->deleteLater();
-            MainWindow::topbar()->setAlwaysShow(true);
-        });
     }
 
-    void loadVideo(const QString& videoId, int progress, PreloadData::WatchView* preload)
+    WatchView* createWatchView(const QString& videoId, int progress, PreloadData::WatchView* preload)
     {
-        if (WatchView* casted = qobject_cast<WatchView*>(MainWindow::centralWidget()->currentWidget()))
-        {
-            casted->hotLoadVideo(videoId, progress, preload);
-            return;
-        }
-        else if (ChannelView* channelView = qobject_cast<ChannelView*>(MainWindow::centralWidget()->currentWidget()))
-        {
-            channelView->deleteLater();
-        }
-
         WatchView* watchView = new WatchView(videoId, progress, preload);
         MainWindow::centralWidget()->addWidget(watchView);
-        MainWindow::centralWidget()->setCurrentWidget(watchView);
 
-        QObject::connect(MainWindow::topbar()->logo, &TubeLabel::clicked, watchView, [watchView]
-        {
-            watchView->deleteLater();
-            MainWindow::topbar()->setAlwaysShow(true);
-        });
-        QObject::connect(watchView, &WatchView::loadFailed, [watchView](const InnertubeException& ie)
+        QObject::connect(watchView, &WatchView::loadFailed, watchView, [watchView](const InnertubeException& ie)
         {
             QMessageBox::critical(nullptr, "Failed to load video", ie.message());
-            watchView->deleteLater();
-            MainWindow::topbar()->setAlwaysShow(true);
-            MainWindow::topbar()->show();
+            NavigationHistory::instance()->discard(watchView);
+        });
+
+        return watchView;
+    }
+
+    void loadChannel(const QString& channelId)
+    {
+        NavigationHistory::instance()->open(NavigationHistory::Kind::Channel, channelId, [channelId] {
+            return createChannelView(channelId);
+        });
+    }
+
+    void loadVideo(const QString& videoId, int progress, PreloadData::WatchView* preload)
+    {
+        NavigationHistory::instance()->open(NavigationHistory::Kind::Video, videoId, [videoId, progress, preload] {
+            return createWatchView(videoId, progress, preload);
         });
     }
 }
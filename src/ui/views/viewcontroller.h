@@ -3,8 +3,17 @@
 
 namespace PreloadData { struct WatchView; }
 
+class ChannelView;
+class WatchView;
+
 namespace ViewController
 {
+    // these open a new page in navigation history
     void loadChannel(const QString& channelId);
     void loadVideo(const QString& videoId, int progress = 0, PreloadData::WatchView* preload = nullptr);
+
+    // these only build the view and add it to the central widget, for navigation history to show.
+    // channels are loaded up front, so nullptr is returned if that fails.
+    ChannelView* createChannelView(const QString& channelId);
+    WatchView* createWatchView(const QString& videoId, int progress = 0, PreloadData::WatchView* preload = nullptr);
 }
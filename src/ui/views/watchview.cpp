@@ -2,7 +2,6 @@
 #include "ui/views/viewcontroller.h"
 #include "ui/widgets/download/downloadmanager.h"
 #include "watchview_ui.h"
-#include "http.h"
 #include "innertube.h"
 #include "mainwindow.h"
 #include "preloaddata.h"
@@ -12,8 +11,13 @@
 #include "ui/widgets/labels/iconlabel.h"
 #include "ui/widgets/subscribe/subscribewidget.h"
 #include "ui/widgets/watchnextfeed.h"
+#include "utils/httpfixtures.h"
+#include "utils/httputils.h"
 #include "utils/innertubestringformatter.h"
+#include "utils/metadatacache.h"
+#include "utils/networkmetrics.h"
 #include "utils/osutils.h"
+#include "utils/searchsuggestions.h"
 #include "utils/stringutils.h"
 #include "utils/uiutils.h"
 #include <QBoxLayout>
@@ -27,12 +31,16 @@
 
 WatchView::~WatchView()
 {
-    disconnect(MainWindow::topbar()->logo, &TubeLabel::clicked, this, nullptr);
-    OSUtils::suspendIdleSleep(false);
-
-    if (QMainWindow* mainWindow = UIUtils::getMainWindow())
-        mainWindow->setWindowTitle(QTTUBE_APP_NAME);
+    // views evicted from navigation history are offscreen, and shouldn't touch whatever's showing now
+    if (isVisible())
+    {
+        OSUtils::suspendIdleSleep(false);
+        if (QMainWindow* mainWindow = UIUtils::getMainWindow())
+            mainWindow->setWindowTitle(QTTUBE_APP_NAME);
+    }
 
+    // hand the player back to the pool before the widget tree takes it down with it
+    delete ui->player;
     delete ui;
 }
 
@@ -51,10 +59,12 @@ WatchView::WatchView(const QString& videoId, int progress, PreloadData::WatchVie
         processPreloadData(preload);
 
     auto next = InnerTube::instance()->get<InnertubeEndpoints::Next>(videoId);
+    NetworkMetrics::instance()->track(next, "Next");
     connect(next, &InnertubeReply<InnertubeEndpoints::Next>::finished, this, &WatchView::processNext);
     connect(next, &InnertubeReply<InnertubeEndpoints::Next>::exception, this, &WatchView::loadFailed);
 
     auto player = InnerTube::instance()->get<InnertubeEndpoints::Player>(videoId);
+    NetworkMetrics::instance()->track(player, "Player");
     connect(player, &InnertubeReply<InnertubeEndpoints::Player>::finished, this, &WatchView::processPlayer);
     connect(player, &InnertubeReply<InnertubeEndpoints::Player>::exception, this, &WatchView::loadFailed);
 
@@ -62,6 +72,55 @@ WatchView::WatchView(const QString& videoId, int progress, PreloadData::WatchVie
     connect(ui->description, &TubeLabel::linkActivated, this, &WatchView::descriptionLinkActivated);
 }
 
+void WatchView::applyMetadata(const QString& videoId, const InnertubeEndpoints::UpdatedMetadataResponse& response)
+{
+    if (response.dateText != appliedMetadata.dateText)
+    {
+        appliedMetadata.dateText = response.dateText;
+        if (qsizetype superTitleIndex = ui->date->text().indexOf(" | "); superTitleIndex != -1)
+            ui->date->setText(response.dateText + ui->date->text().mid(superTitleIndex));
+        else
+            ui->date->setText(response.dateText);
+    }
+
+    if (QString description = InnertubeStringFormatter::formatSimple(response.description, false);
+        description != appliedMetadata.description)
+    {
+        appliedMetadata.description = description;
+        ui->description->setText(description);
+    }
+
+    if (response.likeCountEntity.expandedLikeCountIfIndifferent != appliedMetadata.likes)
+    {
+        appliedMetadata.likes = response.likeCountEntity.expandedLikeCountIfIndifferent;
+        ui->likeLabel->setProperty("fullCount", StringUtils::extractDigits(appliedMetadata.likes));
+        ui->likeLabel->setText(qtTubeApp->settings().condensedCounts
+                                   ? response.likeCountEntity.likeCountIfIndifferent
+                                   : appliedMetadata.likes);
+
+        // the like bar is relative to the like count, so dislikes only need another look when that moves
+        if (qtTubeApp->settings().returnDislikes)
+        {
+            MetadataCache::instance()->get(MetadataCache::Source::ReturnYouTubeDislike, videoId, this,
+                                           std::bind_front(&WatchView::setDislikes, this));
+        }
+    }
+
+    if (response.title.text != appliedMetadata.title)
+    {
+        appliedMetadata.title = response.title.text;
+        ui->titleLabel->setText(appliedMetadata.title);
+        if (QMainWindow* mainWindow = UIUtils::getMainWindow(); mainWindow && isVisible())
+            mainWindow->setWindowTitle(appliedMetadata.title + " - " + QTTUBE_APP_NAME);
+    }
+
+    if (response.viewCount.viewCount.text != appliedMetadata.viewCount)
+    {
+        appliedMetadata.viewCount = response.viewCount.viewCount.text;
+        ui->viewCount->setText(appliedMetadata.viewCount);
+    }
+}
+
 void WatchView::descriptionLinkActivated(const QString& url)
 {
     QUrl qUrl(url);
@@ -76,19 +135,17 @@ void WatchView::descriptionLinkActivated(const QString& url)
     }
     else if (url.startsWith("/watch"))
     {
-        ui->scrollArea->verticalScrollBar()->setValue(0);
-
         QUrlQuery query(qUrl);
         int progress = query.queryItemValue("t").replace("s", "").toInt();
 
         if (query.queryItemValue("continuePlayback") == "1")
         {
+            ui->scrollArea->verticalScrollBar()->setValue(0);
             ui->player->seek(progress);
         }
         else
         {
-            hotLoadVideo(query.queryItemValue("v"), progress);
-            ui->toggleShowMore();
+            ViewController::loadVideo(query.queryItemValue("v"), progress);
         }
     }
     else
@@ -97,32 +154,6 @@ void WatchView::descriptionLinkActivated(const QString& url)
     }
 }
 
-void WatchView::hotLoadVideo(const QString& videoId, int progress, PreloadData::WatchView* preload)
-{
-    ui->feed->reset();
-    ui->scrollArea->horizontalScrollBar()->setValue(0);
-    ui->scrollArea->verticalScrollBar()->setValue(0);
-
-    if (metadataUpdateTimer)
-        metadataUpdateTimer->deleteLater();
-
-    UIUtils::clearLayout(ui->topLevelButtons);
-    disconnect(ui->channelLabel->text, &TubeLabel::clicked, nullptr, nullptr);
-
-    if (preload)
-        processPreloadData(preload);
-
-    auto next = InnerTube::instance()->get<InnertubeEndpoints::Next>(videoId);
-    connect(next, &InnertubeReply<InnertubeEndpoints::Next>::finished, this, &WatchView::processNext);
-    connect(next, &InnertubeReply<InnertubeEndpoints::Next>::exception, this, &WatchView::loadFailed);
-
-    auto player = InnerTube::instance()->get<InnertubeEndpoints::Player>(videoId);
-    connect(player, &InnertubeReply<InnertubeEndpoints::Player>::finished, this, &WatchView::processPlayer);
-    connect(player, &InnertubeReply<InnertubeEndpoints::Player>::exception, this, &WatchView::loadFailed);
-
-    ui->player->play(videoId, progress);
-}
-
 void WatchView::likeOrDislike(bool like, const InnertubeObjects::ToggleButtonViewModel& toggleButton)
 {
     IconLabel* senderLabel = qobject_cast<IconLabel*>(sender());
@@ -237,7 +268,7 @@ void WatchView::processNext(const InnertubeEndpoints::Next& endpoint)
 
     if (const InnertubeObjects::GenericThumbnail* recThumbnail = secondaryInfo.owner.thumbnail.recommendedQuality(QSize(48, 48)))
     {
-        HttpReply* reply = Http::instance().get(recThumbnail->url);
+        HttpReply* reply = HttpUtils::get(recThumbnail->url);
         connect(reply, &HttpReply::finished, this, &WatchView::setChannelIcon);
     }
 
@@ -248,8 +279,8 @@ void WatchView::processNext(const InnertubeEndpoints::Next& endpoint)
 
     if (qtTubeApp->settings().returnDislikes)
     {
-        HttpReply* reply = Http::instance().get("https://returnyoutubedislikeapi.com/votes?videoId=" + nextResp.videoId);
-        connect(reply, &HttpReply::finished, this, &WatchView::setDislikes);
+        MetadataCache::instance()->get(MetadataCache::Source::ReturnYouTubeDislike, nextResp.videoId, this,
+                                       std::bind_front(&WatchView::setDislikes, this));
     }
     else
     {
@@ -268,6 +299,15 @@ void WatchView::processNext(const InnertubeEndpoints::Next& endpoint)
     ui->description->setVisible(!ui->description->text().isEmpty());
     ui->showMoreLabel->setVisible(ui->description->heightForWidth(ui->description->width()) > ui->description->maximumHeight());
     ui->feed->setData(endpoint);
+    emit metadataLoaded();
+
+    // wait for the layout to catch up with everything that was just added, or there's nothing to scroll through yet
+    if (pendingScrollPosition > 0)
+    {
+        QTimer::singleShot(0, this, [this, position = std::exchange(pendingScrollPosition, 0)] {
+            ui->scrollArea->verticalScrollBar()->setValue(position);
+        });
+    }
 }
 
 void WatchView::processPlayer(const InnertubeEndpoints::Player& endpoint)
@@ -275,14 +315,21 @@ void WatchView::processPlayer(const InnertubeEndpoints::Player& endpoint)
     const InnertubeEndpoints::PlayerResponse& playerResp = endpoint.response;
     ui->player->startTracking(playerResp);
     ui->titleLabel->setText(playerResp.videoDetails.title);
+    SearchSuggestions::instance()->addToHistory(playerResp.videoDetails.title);
 
-    if (QMainWindow* mainWindow = UIUtils::getMainWindow())
+    // this can land after the view has been left, and the title belongs to whatever's showing now
+    if (QMainWindow* mainWindow = UIUtils::getMainWindow(); mainWindow && isVisible())
         mainWindow->setWindowTitle(playerResp.videoDetails.title + " - " + QTTUBE_APP_NAME);
 
     if (playerResp.videoDetails.isLive || playerResp.videoDetails.isUpcoming)
     {
+        appliedMetadata = AppliedMetadata();
+
+        // single shot, updateMetadata() rearms it with whatever interval the server asks for.
+        // the first update goes out early so that interval is known sooner rather than later.
         metadataUpdateTimer = new QTimer(this);
-        metadataUpdateTimer->setInterval(60000);
+        metadataUpdateTimer->setInterval(5000);
+        metadataUpdateTimer->setSingleShot(true);
         connect(metadataUpdateTimer, &QTimer::timeout, this, std::bind(&WatchView::updateMetadata, this, playerResp.videoDetails.videoId));
         metadataUpdateTimer->start();
     }
@@ -294,7 +341,7 @@ void WatchView::processPreloadData(PreloadData::WatchView* preload)
     {
         if (const InnertubeObjects::GenericThumbnail* recAvatar = preload->channelAvatar->recommendedQuality(QSize(48, 48)))
         {
-            HttpReply* reply = Http::instance().get(recAvatar->url);
+            HttpReply* reply = HttpUtils::get(recAvatar->url);
             connect(reply, &HttpReply::finished, this, &WatchView::setChannelIcon);
         }
     }
@@ -305,6 +352,11 @@ void WatchView::processPreloadData(PreloadData::WatchView* preload)
         ui->titleLabel->setText(preload->title.value());
 }
 
+int WatchView::progress() const
+{
+    return ui->player->progress();
+}
+
 void WatchView::resizeEvent(QResizeEvent* event)
 {
     if (!ui->primaryInfoWrapper || !event->oldSize().isValid())
@@ -324,6 +376,23 @@ void WatchView::resizeEvent(QResizeEvent* event)
     ui->titleLabel->setFixedWidth(width);
 }
 
+void WatchView::restoreScrollPosition(int position)
+{
+    pendingScrollPosition = position;
+}
+
+void WatchView::resume()
+{
+    ui->player->resume();
+    if (metadataUpdateTimer && !metadataUpdateTimer->isActive())
+        metadataUpdateTimer->start();
+}
+
+int WatchView::scrollPosition() const
+{
+    return ui->scrollArea->verticalScrollBar()->value();
+}
+
 void WatchView::setChannelIcon(const HttpReply& reply)
 {
     QPixmap pixmap;
@@ -331,16 +400,16 @@ void WatchView::setChannelIcon(const HttpReply& reply)
     ui->channelIcon->setPixmap(pixmap);
 }
 
-void WatchView::setDislikes(const HttpReply& reply)
+void WatchView::setDislikes(const QByteArray& body)
 {
-    if (!reply.isSuccessful())
+    if (body.isEmpty())
     {
         if (ui->dislikeLabel->text().isEmpty())
             ui->dislikeLabel->setText("Dislike");
         return;
     }
 
-    QJsonDocument doc = QJsonDocument::fromJson(reply.body());
+    QJsonDocument doc = QJsonDocument::fromJson(body);
     qint64 dislikes = doc["dislikes"].toVariant().toLongLong();
     qint64 likes = QLocale::system().toLongLong(ui->likeLabel->property("fullCount").toString());
 
@@ -363,6 +432,24 @@ void WatchView::setDislikes(const HttpReply& reply)
     ui->dislikeLabel->setText(QLocale::system().toString(dislikes));
 }
 
+void WatchView::stopMetadataUpdates()
+{
+    // an update still in flight would otherwise land on whatever is loaded next
+    if (metadataUpdateReply)
+        disconnect(metadataUpdateReply, nullptr, this, nullptr);
+    if (metadataUpdateTimer)
+        metadataUpdateTimer->deleteLater();
+}
+
+void WatchView::suspend()
+{
+    // a suspended player's state changes aren't reported, so its pause won't let the system sleep again
+    ui->player->suspend();
+    OSUtils::suspendIdleSleep(false);
+    if (metadataUpdateTimer)
+        metadataUpdateTimer->stop();
+}
+
 // most logic courtesy of https://github.com/Rehike/Rehike
 InnertubeObjects::InnertubeString WatchView::unattributeDescription(const InnertubeObjects::DynamicText& attributedDescription)
 {
@@ -396,30 +483,31 @@ InnertubeObjects::InnertubeString WatchView::unattributeDescription(const Innert
 
 void WatchView::updateMetadata(const QString& videoId)
 {
-    try
-    {
-        auto endpoint = InnerTube::instance()->getBlocking<InnertubeEndpoints::UpdatedMetadata>(videoId);
-        if (size_t superTitleIndex = ui->date->text().indexOf(" | "); superTitleIndex != -1)
-            ui->date->setText(endpoint.response.dateText + ui->date->text().mid(superTitleIndex));
-        else
-            ui->date->setText(endpoint.response.dateText);
+    // requested raw for the continuation timeout, which the parsed endpoint doesn't keep
+    auto reply = HttpFixtures::getRaw<InnertubeEndpoints::UpdatedMetadata>("UpdatedMetadata", videoId);
+    NetworkMetrics::instance()->track(reply, "UpdatedMetadata");
+    metadataUpdateReply = reply;
 
-        ui->description->setText(InnertubeStringFormatter::formatSimple(endpoint.response.description, false));
-        ui->likeLabel->setText(qtTubeApp->settings().condensedCounts
-                                   ? endpoint.response.likeCountEntity.likeCountIfIndifferent
-                                   : endpoint.response.likeCountEntity.expandedLikeCountIfIndifferent);
-        ui->titleLabel->setText(endpoint.response.title.text);
-        ui->viewCount->setText(endpoint.response.viewCount.viewCount.text);
+    connect(reply, &InnertubeReply<InnertubeEndpoints::UpdatedMetadata>::exception, this, [this](const InnertubeException& ie) {
+        qDebug() << ie.message() << "Stream/premiere could have ended - killing update timer.";
+        stopMetadataUpdates();
+    });
+    connect(reply, &InnertubeReply<InnertubeEndpoints::UpdatedMetadata>::finishedRaw, this, [this, videoId](const QJsonValue& data) {
+        const auto endpoint = InnerTube::tryCreate<InnertubeEndpoints::UpdatedMetadata>(data);
+        if (!endpoint)
+        {
+            qDebug() << endpoint.error().message() << "Stream/premiere could have ended - killing update timer.";
+            stopMetadataUpdates();
+            return;
+        }
 
-        if (qtTubeApp->settings().returnDislikes)
+        applyMetadata(videoId, endpoint->response);
+
+        // suspended views pick updates back up from resume()
+        if (metadataUpdateTimer && isVisible())
         {
-            HttpReply* reply = Http::instance().get("https://returnyoutubedislikeapi.com/votes?videoId=" + videoId);
-            connect(reply, &HttpReply::finished, this, &WatchView::setDislikes);
+            const int timeoutMs = data["continuation"]["timedContinuationData"]["timeoutMs"].toInt();
+            metadataUpdateTimer->start(timeoutMs > 0 ? std::max(timeoutMs, 1000) : 60000);
         }
-    }
-    catch (const InnertubeException& ie)
-    {
-        qDebug() << ie.message() << "Stream/premiere could have ended - killing update timer.";
-        metadataUpdateTimer->deleteLater();
-    }
+    });
 }
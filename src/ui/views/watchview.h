@@ -31,15 +31,37 @@ public:
     explicit WatchView(const QString& videoId, int progress = 0,
                        PreloadData::WatchView* preload = nullptr, QWidget* parent = nullptr);
     ~WatchView();
-    void hotLoadVideo(const QString& videoId, int progress = 0, PreloadData::WatchView* preload = nullptr);
+    int progress() const;
+    // scrolls to position once the page has loaded, for a view being rebuilt from navigation history
+    void restoreScrollPosition(int position);
+    int scrollPosition() const;
+
+    // for navigation history, which keeps views around offscreen after they've been left
+    void resume();
+    void suspend();
 protected:
     void resizeEvent(QResizeEvent* event) override;
 private:
+    // what updateMetadata() last put on screen, so refreshes only touch what actually changed
+    struct AppliedMetadata
+    {
+        QString dateText;
+        QString description;
+        QString likes;
+        QString title;
+        QString viewCount;
+    };
+
+    AppliedMetadata appliedMetadata;
     QString channelId;
+    QPointer<QObject> metadataUpdateReply;
     QPointer<QTimer> metadataUpdateTimer;
+    int pendingScrollPosition{};
     Ui::WatchView* ui;
 
+    void applyMetadata(const QString& videoId, const InnertubeEndpoints::UpdatedMetadataResponse& response);
     void processPreloadData(PreloadData::WatchView* preload);
+    void stopMetadataUpdates();
     InnertubeObjects::InnertubeString unattributeDescription(const InnertubeObjects::DynamicText& attributedDescription);
     void updateMetadata(const QString& videoId);
 private slots:
@@ -49,7 +71,8 @@ private slots:
     void processNext(const InnertubeEndpoints::Next& endpoint);
     void processPlayer(const InnertubeEndpoints::Player& endpoint);
     void setChannelIcon(const HttpReply& reply);
-    void setDislikes(const HttpReply& reply);
+    void setDislikes(const QByteArray& body);
 signals:
     void loadFailed(const InnertubeException& ie);
+    void metadataLoaded();
 };
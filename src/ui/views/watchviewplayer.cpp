@@ -6,14 +6,20 @@
 #include <QMessageBox>
 #include <QProcess>
 
+WatchViewPlayer::~WatchViewPlayer()
+{
+    WebEnginePlayer::release(m_player);
+}
+
 WatchViewPlayer::WatchViewPlayer(QWidget* watchView, const QSize& maxSize) : QObject(watchView)
 {
     if (qtTubeApp->settings().externalPlayerPath.isEmpty())
     {
-        m_player = new WebEnginePlayer(watchView);
+        m_player = WebEnginePlayer::acquire(watchView);
         m_player->setAuthStore(InnerTube::instance()->authStore());
         m_player->setContext(InnerTube::instance()->context());
         connect(m_player, &WebEnginePlayer::progressChanged, this, &WatchViewPlayer::progressChanged);
+        connect(m_player, &WebEnginePlayer::progressChanged, this, [this](double progress) { m_progress = progress; });
     }
 
     calcAndSetSize(maxSize);
@@ -48,6 +54,8 @@ void WatchViewPlayer::calcAndSetSize(const QSize& maxSize)
 
 void WatchViewPlayer::play(const QString& videoId, int progress)
 {
+    m_progress = progress;
+
     if (QString playerPath = qtTubeApp->settings().externalPlayerPath; !playerPath.isEmpty())
     {
         // using splitCommand + start instead of startCommand for Qt 5.15 support
@@ -64,6 +72,12 @@ void WatchViewPlayer::play(const QString& videoId, int progress)
     }
 }
 
+void WatchViewPlayer::resume()
+{
+    if (m_player)
+        m_player->activate();
+}
+
 void WatchViewPlayer::seek(int progress)
 {
     if (m_player)
@@ -76,6 +90,12 @@ void WatchViewPlayer::showSharePanel()
         m_player->showSharePanel();
 }
 
+void WatchViewPlayer::suspend()
+{
+    if (m_player)
+        m_player->suspend();
+}
+
 void WatchViewPlayer::startTracking(const InnertubeEndpoints::PlayerResponse& playerResp)
 {
     if (m_player)
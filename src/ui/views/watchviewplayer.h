@@ -1,5 +1,6 @@
 #pragma once
 #include <QObject>
+#include <QPointer>
 #include <QSize>
 
 class WebEnginePlayer;
@@ -12,17 +13,24 @@ public:
     enum class ScaleMode { Unset, NoScale, Scaled };
 
     WatchViewPlayer(QWidget* watchView, const QSize& maxSize);
+    ~WatchViewPlayer();
     void calcAndSetSize(const QSize& maxSize);
     void play(const QString& videoId, int progress = 0);
+    // for a player that's being shown again after another one was in use
+    void resume();
     void seek(int progress);
     void showSharePanel();
+    // pauses the player until resume(), see WebEnginePlayer::suspend()
+    void suspend();
     void startTracking(const InnertubeEndpoints::PlayerResponse& playerResp);
     QWidget* widget();
 
+    int progress() const { return m_progress; }
     QSize size() const { return m_size; }
     ScaleMode scaleMode() const { return m_scaleMode; }
 private:
-    WebEnginePlayer* m_player{};
+    QPointer<WebEnginePlayer> m_player;
+    int m_progress{}; // seconds
     ScaleMode m_scaleMode;
     QSize m_size;
 signals:
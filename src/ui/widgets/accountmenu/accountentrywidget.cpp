@@ -18,7 +18,7 @@ AccountEntryWidget::AccountEntryWidget(const CredentialSet& credSet, QWidget* pa
     nameLabel->setText(credSet.username);
     layout->addWidget(nameLabel);
 
-    HttpReply* reply = HttpUtils::cachedInstance().get(QUrl(credSet.avatarUrl));
+    HttpReply* reply = HttpUtils::get(QUrl(credSet.avatarUrl), true);
     connect(reply, &HttpReply::finished, this, &AccountEntryWidget::setAvatar);
 }
 
@@ -1,12 +1,14 @@
 #include "accountmenuwidget.h"
 #include "innertube/endpoints/misc/accountmenu.h"
 #include "mainwindow.h"
+#include "qttubeapplication.h"
 #include "ui/views/viewcontroller.h"
 #include "ui/widgets/labels/iconlabel.h"
 #include "utils/httputils.h"
 #include "utils/tubeutils.h"
 #include "utils/uiutils.h"
 #include <QBoxLayout>
+#include <QPointer>
 
 AccountMenuWidget::AccountMenuWidget(QWidget* parent)
     : QWidget(parent),
@@ -44,6 +46,22 @@ AccountMenuWidget::AccountMenuWidget(QWidget* parent)
     connect(signOutLabel, &IconLabel::clicked, this, &AccountMenuWidget::triggerSignOut);
 }
 
+void AccountMenuWidget::initialize(const CredentialSet& credSet)
+{
+    accountNameLabel->setText(credSet.username);
+    handleLabel->setText(credSet.handle);
+    setChannelId(credSet.channelId);
+
+    if (!credSet.avatarUrl.isEmpty())
+    {
+        HttpReply* avatarReply = HttpUtils::get(QUrl(credSet.avatarUrl), true);
+        connect(avatarReply, &HttpReply::finished, this, &AccountMenuWidget::setAvatar);
+    }
+
+    adjustSize();
+    emit finishedInitializing();
+}
+
 void AccountMenuWidget::initialize(const InnertubeEndpoints::AccountMenu& endpoint)
 {
     const InnertubeObjects::ActiveAccountHeader& header = endpoint.response.header;
@@ -52,12 +70,24 @@ void AccountMenuWidget::initialize(const InnertubeEndpoints::AccountMenu& endpoi
 
     if (const InnertubeObjects::GenericThumbnail* recAvatar = header.accountPhoto.recommendedQuality(avatar->size()))
     {
-        HttpReply* avatarReply = HttpUtils::cachedInstance().get(QUrl(recAvatar->url));
+        HttpReply* avatarReply = HttpUtils::get(QUrl(recAvatar->url), true);
         connect(avatarReply, &HttpReply::finished, this, &AccountMenuWidget::setAvatar);
     }
 
-    QString channelId = TubeUtils::getUcidFromUrl("https://www.youtube.com/" + header.channelHandle);
-    connect(yourChannelLabel, &IconLabel::clicked, this, std::bind(&AccountMenuWidget::gotoChannel, this, channelId));
+    // the stored login already knows the channel for this handle unless the account is new
+    const CredentialSet* activeLogin = qtTubeApp->creds().activeLogin();
+    if (activeLogin && activeLogin->handle == header.channelHandle)
+    {
+        setChannelId(activeLogin->channelId);
+    }
+    else
+    {
+        QPointer<AccountMenuWidget> self(this);
+        TubeUtils::getUcidFromUrl("https://www.youtube.com/" + header.channelHandle).then([self](const QString& channelId) {
+            if (self)
+                self->setChannelId(channelId);
+        });
+    }
 
     adjustSize();
     emit finishedInitializing();
@@ -77,6 +107,14 @@ void AccountMenuWidget::setAvatar(const HttpReply& reply)
     avatar->setPixmap(UIUtils::pixmapRounded(pixmap));
 }
 
+void AccountMenuWidget::setChannelId(const QString& channelId)
+{
+    disconnect(yourChannelLabel, &IconLabel::clicked, this, nullptr);
+    yourChannelLabel->setEnabled(!channelId.isEmpty());
+    if (!channelId.isEmpty())
+        connect(yourChannelLabel, &IconLabel::clicked, this, std::bind(&AccountMenuWidget::gotoChannel, this, channelId));
+}
+
 void AccountMenuWidget::triggerSignOut()
 {
     hide();
@@ -8,6 +8,7 @@ class IconLabel;
 class QHBoxLayout;
 class QLabel;
 class QVBoxLayout;
+struct CredentialSet;
 
 class AccountMenuWidget : public QWidget
 {
@@ -24,7 +25,11 @@ private:
     IconLabel* signOutLabel;
     IconLabel* switchAccountsLabel;
     IconLabel* yourChannelLabel;
+
+    void setChannelId(const QString& channelId);
 public slots:
+    // shows what's stored for the login straight away, before the account menu request comes back
+    void initialize(const CredentialSet& credSet);
     void initialize(const InnertubeEndpoints::AccountMenu& endpoint);
 private slots:
     void gotoChannel(const QString& channelId);
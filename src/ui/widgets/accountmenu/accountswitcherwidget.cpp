@@ -52,6 +52,8 @@ void AccountSwitcherWidget::addAccount()
 void AccountSwitcherWidget::switchAccount(const CredentialSet& credSet)
 {
     hide();
+    // everything the switch needs to show is stored with the login, the account menu request only refreshes it
+    qtTubeApp->creds().setActiveLogin(credSet.channelId);
     qtTubeApp->creds().populateAuthStore(credSet);
     MainWindow::topbar()->postSignInSetup();
     emit closeRequested();
@@ -1,13 +1,94 @@
 #include "continuablelistwidget.h"
 #include "innertube.h"
 #include "qttubeapplication.h"
+#include "utils/requestscheduler.h"
 #include <QScrollBar>
+#include <QTimer>
 #include <QWheelEvent>
 
-ContinuableListWidget::ContinuableListWidget(QWidget* parent) : QListWidget(parent)
+ContinuableListWidget::ContinuableListWidget(QWidget* parent) : QListWidget(parent), priorityTimer(new QTimer(this))
 {
     setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+
+    // item images are only loaded once updateRequestPriorities() finds them near the visible area
+    RequestScheduler::instance()->deferWithin(this);
+
+    // scrolling and population both come in bursts, so only re-rank requests once things settle down a bit
+    priorityTimer->setInterval(100);
+    priorityTimer->setSingleShot(true);
+
+    connect(priorityTimer, &QTimer::timeout, this, &ContinuableListWidget::updateNearbyRequestPriorities);
     connect(verticalScrollBar(), &QScrollBar::valueChanged, this, &ContinuableListWidget::scrollValueChanged);
+    connect(model(), &QAbstractItemModel::rowsInserted, priorityTimer, qOverload<>(&QTimer::start));
+}
+
+void ContinuableListWidget::beginMerge()
+{
+    mergeRow = 0;
+    mergeAnchor = model()->index(firstRowReaching(0), 0);
+    mergeAnchorTop = visualRect(mergeAnchor).top();
+}
+
+void ContinuableListWidget::endMerge()
+{
+    removeMergedRows(mergeRow, count());
+    mergeRow = -1;
+
+    // rows may have come and gone above the anchor, so a plain scroll value would land somewhere else
+    if (mergeAnchor.isValid())
+        verticalScrollBar()->setValue(verticalScrollBar()->value() + visualRect(mergeAnchor).top() - mergeAnchorTop);
+    mergeAnchor = QPersistentModelIndex();
+}
+
+// items are laid out top to bottom (a row at a time in grids), so this can be binary searched for
+int ContinuableListWidget::firstRowReaching(int y) const
+{
+    int first = 0;
+    for (int last = count(); first < last;)
+    {
+        const int mid = (first + last) / 2;
+        if (visualItemRect(item(mid)).bottom() < y)
+            first = mid + 1;
+        else
+            last = mid;
+    }
+    return first;
+}
+
+void ContinuableListWidget::insertMergedItem(QListWidgetItem* item)
+{
+    // processEvents() is called while lists are populated, so the list could have been cleared in the meantime
+    mergeRow = std::min(mergeRow, count());
+    insertItem(mergeRow++, item);
+}
+
+bool ContinuableListWidget::keepMergedRow(const QString& videoId)
+{
+    if (mergeRow == -1 || videoId.isEmpty())
+        return false;
+
+    for (int i = mergeRow; i < count(); ++i)
+    {
+        if (item(i)->data(VideoIdRole).toString() == videoId)
+        {
+            removeMergedRows(mergeRow, i);
+            ++mergeRow;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ContinuableListWidget::removeMergedRows(int from, int to)
+{
+    const bool hadAnchor = mergeAnchor.isValid();
+    for (int i = from; i < to; ++i)
+        delete takeItem(from);
+
+    // the view is kept on whatever takes the anchor's place
+    if (hadAnchor && !mergeAnchor.isValid())
+        mergeAnchor = model()->index(from, 0);
 }
 
 void ContinuableListWidget::scrollValueChanged(int value)
@@ -18,6 +99,17 @@ void ContinuableListWidget::scrollValueChanged(int value)
     {
         emit continuationReady();
     }
+
+    priorityTimer->start();
+}
+
+void ContinuableListWidget::setPopulatingFlag(bool populating)
+{
+    if (this->populating == populating)
+        return;
+
+    this->populating = populating;
+    emit populatingChanged(populating);
 }
 
 void ContinuableListWidget::toggleListGridLayout()
@@ -41,12 +133,56 @@ void ContinuableListWidget::toggleListGridLayout()
     }
 }
 
+// images for items in view go first, then items within the prefetch margin since they're likely to be scrolled to soon.
+// everything else isn't loaded until it gets closer.
+// only items near the visible area are looked at, so this stays cheap however long the list gets. the rest are either
+// still held back from when they were added, or were ranked by an earlier pass and are put back to deferred here.
+void ContinuableListWidget::updateNearbyRequestPriorities()
+{
+    const QRect viewportRect = viewport()->rect();
+    const int margin = viewportRect.height() * qtTubeApp->settings().imagePrefetchScreens;
+    const QRect nearbyRect = viewportRect.adjusted(0, -margin, 0, margin);
+
+    QList<QPointer<QWidget>> nearbyWidgets;
+    for (int i = firstRowReaching(nearbyRect.top()); i < count(); ++i)
+    {
+        QListWidgetItem* listItem = item(i);
+        const QRect rect = visualItemRect(listItem);
+        if (rect.top() > nearbyRect.bottom())
+            break;
+
+        QWidget* widget = itemWidget(listItem);
+        if (!widget)
+            continue;
+
+        RequestScheduler::instance()->setPriority(widget,
+            rect.intersects(viewportRect) ? RequestPriority::Visible : RequestPriority::Prefetch);
+        nearbyWidgets.append(widget);
+    }
+
+    for (const QPointer<QWidget>& widget : std::as_const(rankedWidgets))
+        if (widget && !nearbyWidgets.contains(widget))
+            RequestScheduler::instance()->setPriority(widget, RequestPriority::Deferred);
+
+    rankedWidgets = nearbyWidgets;
+}
+
+void ContinuableListWidget::updateRequestPriorities()
+{
+    // anything in the list could have been raised from outside, so start over
+    RequestScheduler::instance()->setPriority(this, RequestPriority::Deferred);
+    rankedWidgets.clear();
+    updateNearbyRequestPriorities();
+}
+
 // singleStep is reset when changing the list to a grid, this makes sure it stays at 25
 // without needing any extra code in individual usages
 void ContinuableListWidget::updateGeometries()
 {
     QListView::updateGeometries();
     verticalScrollBar()->setSingleStep(25);
+    // resizing can bring items into view without any scrolling
+    priorityTimer->start();
 }
 
 // circumvent qt bug(?) where QWheelEvent is still accepted when attempting to scroll on a disabled scroll bar.
@@ -1,26 +1,57 @@
 #pragma once
 #include <QListWidget>
+#include <QPersistentModelIndex>
+#include <QPointer>
+
+class QTimer;
 
 class ContinuableListWidget : public QListWidget
 {
     Q_OBJECT
 public:
+    // set on rows for videos by UIUtils, so merges can tell which rows are already there
+    static constexpr int VideoIdRole = Qt::UserRole;
+
     QString continuationToken;
 
     explicit ContinuableListWidget(QWidget* parent = nullptr);
+    // for refreshing a list that's already filled without starting over. between beginMerge() and endMerge(),
+    // rows added through UIUtils go in order among the existing ones, and rows for videos that are already there
+    // are kept as they are (thumbnails and all) instead of being built again. whatever isn't part of the refresh
+    // is removed, and the view is kept on the row it was on.
+    void beginMerge();
+    void endMerge();
+    void insertMergedItem(QListWidgetItem* item);
+    bool isMerging() const { return mergeRow != -1; }
+    // during a merge, keeps the upcoming row for videoId (dropping any rows before it that weren't kept).
+    // returns false if there isn't one, in which case the row has to be built.
+    bool keepMergedRow(const QString& videoId);
     void setContinuationThreshold(int threshold) { continuationThreshold = threshold; }
     void toggleListGridLayout();
+    // re-ranks item image requests by how close they are to the visible area. this happens by itself after scrolling,
+    // population and resizing, but a list coming back from being suspended has to ask.
+    void updateRequestPriorities();
 
     bool isPopulating() const { return populating; }
-    void setPopulatingFlag(bool populating) { this->populating = populating; }
+    void setPopulatingFlag(bool populating);
 protected:
     void updateGeometries() override;
     void wheelEvent(QWheelEvent* event) override;
 private:
     int continuationThreshold = 10;
+    QPersistentModelIndex mergeAnchor; // the first row in view when the merge began
+    int mergeAnchorTop{};
+    int mergeRow = -1; // the first existing row the merge hasn't gotten to
     bool populating{};
+    QTimer* priorityTimer;
+    QList<QPointer<QWidget>> rankedWidgets; // item widgets near the visible area as of the last pass
+
+    int firstRowReaching(int y) const;
+    void removeMergedRows(int from, int to);
 private slots:
     void scrollValueChanged(int value);
+    void updateNearbyRequestPriorities();
 signals:
     void continuationReady();
+    void populatingChanged(bool populating);
 };
@@ -1,4 +1,5 @@
 #include "dynamiclistwidgetitem.h"
+#include "findbar.h"
 #include <QResizeEvent>
 
 bool ResizeEventFilter::eventFilter(QObject* obj, QEvent* event)
@@ -13,6 +14,7 @@ void DynamicListWidgetItem::setWidget(QWidget* widget)
     setSizeHint(widget->sizeHint());
     listWidget()->addItem(this);
     listWidget()->setItemWidget(this, widget);
+    FindBar::indexListItem(this, widget);
 
     ResizeEventFilter* eventFilter = new ResizeEventFilter(widget);
     widget->installEventFilter(eventFilter);
@@ -8,8 +8,10 @@
 #include <QListWidget>
 #include <QPushButton>
 #include <QScrollArea>
+#include <QTimer>
 
 constexpr QLatin1String SelectedStylesheet("background-color: yellow");
+constexpr int SearchDebounceMs = 200;
 
 FindBar::FindBar(QWidget* parent)
     : QWidget(parent),
@@ -18,7 +20,8 @@ FindBar::FindBar(QWidget* parent)
       matchesLabel(new QLabel(this)),
       nextButton(new QPushButton(this)),
       previousButton(new QPushButton(this)),
-      searchBox(new QLineEdit(this))
+      searchBox(new QLineEdit(this)),
+      searchTimer(new QTimer(this))
 {
     hbox->addWidget(closeButton);
 
@@ -35,6 +38,9 @@ FindBar::FindBar(QWidget* parent)
 
     hbox->addWidget(matchesLabel);
 
+    searchTimer->setInterval(SearchDebounceMs);
+    searchTimer->setSingleShot(true);
+
     hide();
     setAutoFillBackground(true);
     setPalette(qApp->palette().alternateBase().color());
@@ -43,29 +49,81 @@ FindBar::FindBar(QWidget* parent)
     connect(nextButton, &QPushButton::clicked, this, &FindBar::goToNext);
     connect(previousButton, &QPushButton::clicked, this, &FindBar::goToPrevious);
     connect(searchBox, &QLineEdit::returnPressed, this, &FindBar::returnPressed);
-    connect(searchBox, &QLineEdit::textChanged, this, &FindBar::initializeSearch);
+    connect(searchBox, &QLineEdit::textChanged, searchTimer, qOverload<>(&QTimer::start));
+    connect(searchTimer, &QTimer::timeout, this, &FindBar::initializeSearch);
+}
+
+void FindBar::appendEntries(ListIndex& index, QListWidgetItem* item, QWidget* widget)
+{
+    QListWidget* list = item->listWidget();
+    const QPersistentModelIndex modelIndex(list->model()->index(list->row(item), 0));
+    if (QLabel* label = qobject_cast<QLabel*>(widget))
+        index.entries.append(IndexEntry { .label = label, .list = list, .modelIndex = modelIndex });
+
+    const QList<QLabel*> labels = widget->findChildren<QLabel*>();
+    for (QLabel* label : labels)
+        index.entries.append(IndexEntry { .label = label, .list = list, .modelIndex = modelIndex });
+}
+
+// walks everything outside of list widgets, as list contents are covered by the list index.
+void FindBar::buildLooseIndex(QWidget* widget)
+{
+    const QObjectList& children = widget->children();
+    for (QObject* child : children)
+    {
+        if (!child->isWidgetType() || child == this || qobject_cast<QListWidget*>(child))
+            continue;
+
+        QWidget* childWidget = static_cast<QWidget*>(child);
+        if (QLabel* label = qobject_cast<QLabel*>(childWidget))
+            looseIndex.append(IndexEntry { .label = label });
+        buildLooseIndex(childWidget);
+    }
 }
 
 void FindBar::clearMatches()
 {
-    for (const QPointer<QLabel>& match : std::as_const(matches))
-        unhighlightMatch(match);
+    for (const IndexEntry& match : std::as_const(matches))
+        unhighlightMatch(match.label);
     matches.clear();
     matchesLabel->clear();
     currentIndex = 0;
 }
 
+void FindBar::dropListsWithin(QWidget* container)
+{
+    const QList<QListWidget*> lists = container->findChildren<QListWidget*>();
+    for (QListWidget* list : lists)
+    {
+        if (auto it = listIndexes.find(list); it != listIndexes.end())
+        {
+            it->dropped = true;
+            it->entries.clear();
+        }
+    }
+}
+
+bool FindBar::entryIsSearchable(const IndexEntry& entry) const
+{
+    if (entry.label.isNull())
+        return false;
+    // list entries are only looked at when their list is showing, so only the label itself needs checking
+    if (entry.list)
+        return entry.modelIndex.isValid() && !entry.label->isHidden();
+    return entry.label->isVisible();
+}
+
 void FindBar::goToNext()
 {
     currentIndex++;
-    unhighlightMatch(matches[currentIndex - 1]);
+    unhighlightMatch(matches[currentIndex - 1].label);
     jumpToCurrentMatch();
 }
 
 void FindBar::goToPrevious()
 {
     currentIndex--;
-    unhighlightMatch(matches[currentIndex + 1]);
+    unhighlightMatch(matches[currentIndex + 1].label);
     jumpToCurrentMatch();
 }
 
@@ -75,16 +133,78 @@ void FindBar::highlightMatch(const QPointer<QLabel>& label)
         label->setStyleSheet(label->styleSheet() + SelectedStylesheet);
 }
 
-void FindBar::initializeSearch(const QString& searchText)
+void FindBar::indexListItem(QListWidgetItem* item, QWidget* widget)
 {
+    QListWidget* list = item->listWidget();
+    if (!list)
+        return;
+
+    auto it = listIndexes.find(list);
+    if (it == listIndexes.end())
+    {
+        it = listIndexes.insert(list, ListIndex());
+        QObject::connect(list, &QObject::destroyed, [list] { listIndexes.remove(list); });
+        QObject::connect(list->model(), &QAbstractItemModel::modelReset, list, [list] {
+            if (auto index = listIndexes.find(list); index != listIndexes.end())
+                index->entries.clear();
+        });
+    }
+    else if (it->dropped)
+    {
+        return;
+    }
+
+    if (it->entries.size() >= it->pruneThreshold)
+        pruneListIndex(*it);
+    appendEntries(*it, item, widget);
+}
+
+void FindBar::indexListsWithin(QWidget* container)
+{
+    const QList<QListWidget*> lists = container->findChildren<QListWidget*>();
+    for (QListWidget* list : lists)
+    {
+        auto it = listIndexes.find(list);
+        if (it == listIndexes.end() || !it->dropped)
+            continue;
+
+        it->dropped = false;
+        for (int i = 0; i < list->count(); ++i)
+        {
+            QListWidgetItem* item = list->item(i);
+            if (QWidget* widget = list->itemWidget(item))
+                appendEntries(*it, item, widget);
+        }
+        it->pruneThreshold = std::max<qsizetype>(256, it->entries.size() * 2);
+    }
+}
+
+void FindBar::initializeSearch()
+{
+    searchTimer->stop();
     clearMatches();
+
+    const QString searchText = searchBox->text();
     if (searchText.isEmpty())
         return;
 
-    const QList<QLabel*> labels = parentWidget()->findChildren<QLabel*>();
-    for (QLabel* label : labels)
-        if (label->isVisible() && label->text().contains(searchText, Qt::CaseInsensitive))
-            matches.append(label);
+    const QString needle = searchText.toCaseFolded();
+    auto collectMatches = [this, &needle](QList<IndexEntry>& index) {
+        for (IndexEntry& entry : index)
+        {
+            if (!entryIsSearchable(entry))
+                continue;
+
+            refreshEntry(entry);
+            if (entry.foldedText.contains(needle))
+                matches.append(entry);
+        }
+    };
+
+    collectMatches(looseIndex);
+    for (auto it = listIndexes.begin(); it != listIndexes.end(); ++it)
+        if (it.key()->isVisible() && it.key()->window() == window())
+            collectMatches(it->entries);
 
     jumpToCurrentMatch();
 }
@@ -100,51 +220,63 @@ void FindBar::jumpToCurrentMatch()
         return;
     }
 
-    highlightMatch(matches[currentIndex]);
+    highlightMatch(matches[currentIndex].label);
     matchesLabel->setText(matches.length() > 1
         ? QStringLiteral("%1 of %2 matches").arg(currentIndex + 1).arg(matches.length())
         : QStringLiteral("%1 of 1 match").arg(currentIndex + 1));
 
     // if match found, but the match is deleted, try again
-    if (matches[currentIndex].isNull())
+    const IndexEntry& match = matches[currentIndex];
+    if (match.label.isNull())
     {
-        initializeSearch(searchBox->text());
+        initializeSearch();
         return;
     }
 
-    if (QListWidget* list = UIUtils::findParent<QListWidget*>(matches[currentIndex]))
-    {
-        for (int i = 0; i < list->count(); i++)
-        {
-            if (QWidget* itemWidget = list->itemWidget(list->item(i)))
-            {
-                if (itemWidget->findChildren<QLabel*>().contains(matches[currentIndex]))
-                {
-                    list->scrollToItem(list->item(i));
-                    break;
-                }
-            }
-        }
-    }
-    else if (QScrollArea* scrollArea = UIUtils::findParent<QScrollArea*>(matches[currentIndex]))
+    if (match.list && match.modelIndex.isValid())
+        match.list->scrollTo(match.modelIndex);
+    else if (QScrollArea* scrollArea = UIUtils::findParent<QScrollArea*>(match.label))
+        scrollArea->ensureWidgetVisible(match.label);
+}
+
+void FindBar::pruneListIndex(ListIndex& index)
+{
+    index.entries.erase(std::remove_if(index.entries.begin(), index.entries.end(), [](const IndexEntry& entry) {
+        return entry.label.isNull() || !entry.modelIndex.isValid();
+    }), index.entries.end());
+    index.pruneThreshold = std::max<qsizetype>(256, index.entries.size() * 2);
+}
+
+void FindBar::refreshEntry(IndexEntry& entry)
+{
+    // labels get their text changed after being indexed (dearrow titles, emojis, etc.), so fold lazily
+    if (const QString text = entry.label->text(); text != entry.rawText)
     {
-        scrollArea->ensureWidgetVisible(matches[currentIndex]);
+        entry.rawText = text;
+        entry.foldedText = text.toCaseFolded();
     }
 }
 
 void FindBar::returnPressed()
 {
+    // a search is still pending, so run it rather than advancing through stale matches
+    if (searchTimer->isActive())
+    {
+        initializeSearch();
+        return;
+    }
+
     if (matches.empty())
         return;
 
     if (++currentIndex >= matches.length())
     {
         currentIndex = 0;
-        unhighlightMatch(matches.last());
+        unhighlightMatch(matches.last().label);
     }
     else
     {
-        unhighlightMatch(matches[currentIndex - 1]);
+        unhighlightMatch(matches[currentIndex - 1].label);
     }
 
     jumpToCurrentMatch();
@@ -156,12 +288,16 @@ void FindBar::setReveal(bool reveal)
     {
         move(0, parentWidget()->height() - 50);
         resize(parentWidget()->width(), 50);
+        looseIndex.clear();
+        buildLooseIndex(parentWidget());
         show();
         searchBox->setFocus();
     }
     else
     {
+        searchTimer->stop();
         clearMatches();
+        looseIndex.clear();
         hide();
         nextButton->setEnabled(false);
         previousButton->setEnabled(false);
@@ -1,4 +1,6 @@
 #pragma once
+#include <QHash>
+#include <QPersistentModelIndex>
 #include <QPointer>
 #include <QWidget>
 
@@ -6,30 +8,67 @@ class CloseButton;
 class QHBoxLayout;
 class QLabel;
 class QLineEdit;
+class QListWidget;
+class QListWidgetItem;
 class QPushButton;
+class QTimer;
 
 class FindBar : public QWidget
 {
 public:
     explicit FindBar(QWidget* parent);
     void setReveal(bool reveal);
+
+    // drops what's been indexed for the lists inside container, for views that are put away for a while.
+    // items added to those lists in the meantime aren't indexed until indexListsWithin() is called on them again.
+    static void dropListsWithin(QWidget* container);
+    // registers the labels in a list item's widget so searches don't have to walk the widget tree.
+    static void indexListItem(QListWidgetItem* item, QWidget* widget);
+    static void indexListsWithin(QWidget* container);
 private:
+    struct IndexEntry
+    {
+        QPointer<QLabel> label;
+        QPointer<QListWidget> list;
+        QPersistentModelIndex modelIndex;
+        QString rawText;
+        QString foldedText;
+    };
+
+    struct ListIndex
+    {
+        bool dropped{};
+        QList<IndexEntry> entries;
+        qsizetype pruneThreshold = 256;
+    };
+
+    // by list, so searches only look at lists that are showing
+    static inline QHash<QListWidget*, ListIndex> listIndexes;
+
     CloseButton* closeButton;
     int currentIndex{};
     QHBoxLayout* hbox;
-    QList<QPointer<QLabel>> matches;
+    QList<IndexEntry> looseIndex;
+    QList<IndexEntry> matches;
     QLabel* matchesLabel;
     QPushButton* nextButton;
     QPushButton* previousButton;
     QLineEdit* searchBox;
+    QTimer* searchTimer;
 
+    void buildLooseIndex(QWidget* widget);
     void clearMatches();
+    bool entryIsSearchable(const IndexEntry& entry) const;
     void highlightMatch(const QPointer<QLabel>& label);
     void unhighlightMatch(const QPointer<QLabel>& label);
+
+    static void appendEntries(ListIndex& index, QListWidgetItem* item, QWidget* widget);
+    static void pruneListIndex(ListIndex& index);
+    static void refreshEntry(IndexEntry& entry);
 private slots:
     void goToNext();
     void goToPrevious();
-    void initializeSearch(const QString& searchText);
+    void initializeSearch();
     void jumpToCurrentMatch();
     void returnPressed();
 };
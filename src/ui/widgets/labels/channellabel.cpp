@@ -3,6 +3,7 @@
 #include "innertube.h"
 #include "qttubeapplication.h"
 #include "ui/views/viewcontroller.h"
+#include "utils/networkmetrics.h"
 #include "utils/uiutils.h"
 #include <QBoxLayout>
 #include <QDesktopServices>
@@ -40,7 +41,7 @@ void ChannelLabel::filterThis()
     if (qtTubeApp->settings().channelIsFiltered(channelId))
         return;
 
-    auto channel = InnerTube::instance()->getBlocking<InnertubeEndpoints::BrowseChannel>(channelId);
+    auto channel = NetworkMetrics::instance()->getBlocking<InnertubeEndpoints::BrowseChannel>("BrowseChannel", channelId);
 
     QString channelHandle;
     if (auto c4 = std::get_if<InnertubeObjects::ChannelC4Header>(&channel.response.header))
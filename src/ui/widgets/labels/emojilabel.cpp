@@ -9,7 +9,7 @@ EmojiLabel::EmojiLabel(const QStringList& shortcuts, const QStringList& searchTe
     setScaledContents(true);
     setToolTip(m_primaryShortcut);
 
-    HttpReply* reply = HttpUtils::cachedInstance().get(image);
+    HttpReply* reply = HttpUtils::get(image, true);
     connect(reply, &HttpReply::finished, this, &EmojiLabel::setIcon);
 }
 
@@ -1,5 +1,4 @@
 #include "backstagepostrenderer.h"
-#include "http.h"
 #include "innertube/objects/backstage/backstagepost.h"
 #include "qttubeapplication.h"
 #include "ui/widgets/labels/channellabel.h"
@@ -8,6 +7,7 @@
 #include "ui/widgets/renderers/backstage/backstagepollrenderer.h"
 #include "ui/widgets/renderers/backstage/backstagequizrenderer.h"
 #include "ui/widgets/renderers/video/browsevideorenderer.h"
+#include "utils/httputils.h"
 #include "utils/innertubestringformatter.h"
 #include "utils/stringutils.h"
 #include <QBoxLayout>
@@ -66,7 +66,7 @@ void BackstagePostRenderer::setData(const InnertubeObjects::BackstagePost& post)
 
     if (const InnertubeObjects::GenericThumbnail* avatar = post.authorThumbnail.bestQuality())
     {
-        HttpReply* reply = Http::instance().get("https:" + avatar->url);
+        HttpReply* reply = HttpUtils::get("https:" + avatar->url, false, RequestPriority::Visible, this);
         connect(reply, &HttpReply::finished, this, &BackstagePostRenderer::setChannelIcon);
     }
 
@@ -97,7 +97,7 @@ void BackstagePostRenderer::setImage(const InnertubeObjects::BackstageImage& ima
 
     if (const InnertubeObjects::GenericThumbnail* bestImage = image.image.bestQuality())
     {
-        HttpReply* reply = Http::instance().get(bestImage->url);
+        HttpReply* reply = HttpUtils::get(bestImage->url, false, RequestPriority::Visible, this);
         connect(reply, &HttpReply::finished, this,
                 std::bind_front(&BackstagePostRenderer::setImageLabelData, this, imageLabel));
     }
@@ -1,10 +1,10 @@
 #include "postrenderer.h"
-#include "http.h"
 #include "innertube/objects/backstage/post.h"
 #include "qttubeapplication.h"
 #include "ui/widgets/labels/channellabel.h"
 #include "ui/widgets/labels/iconlabel.h"
 #include "ui/widgets/labels/tubelabel.h"
+#include "utils/httputils.h"
 #include "utils/innertubestringformatter.h"
 #include "utils/stringutils.h"
 #include "utils/uiutils.h"
@@ -68,7 +68,7 @@ void PostRenderer::setData(const InnertubeObjects::Post& post)
 
     if (const InnertubeObjects::GenericThumbnail* avatar = post.authorThumbnail.bestQuality())
     {
-        HttpReply* reply = Http::instance().get("https:" + avatar->url);
+        HttpReply* reply = HttpUtils::get("https:" + avatar->url, false, RequestPriority::Visible, this);
         connect(reply, &HttpReply::finished, this, &PostRenderer::setChannelIcon);
     }
 
@@ -103,7 +103,7 @@ void PostRenderer::setImage(const InnertubeObjects::BackstageImage& image)
 
     if (const InnertubeObjects::GenericThumbnail* bestImage = image.image.bestQuality())
     {
-        HttpReply* reply = Http::instance().get(bestImage->url);
+        HttpReply* reply = HttpUtils::get(bestImage->url, false, RequestPriority::Visible, this);
         connect(reply, &HttpReply::finished, this, std::bind_front(&PostRenderer::setImageLabelData, this, imageLabel));
     }
 }
@@ -1,8 +1,10 @@
 #include "videorenderer.h"
-#include "http.h"
 #include "innertube.h"
 #include "innertube/objects/video/reel.h"
 #include "qttubeapplication.h"
+#include "utils/httputils.h"
+#include "utils/networkmetrics.h"
+#include "utils/tubeutils.h"
 #include "utils/uiutils.h"
 #include "ui/views/preloaddata.h"
 #include "ui/views/viewcontroller.h"
@@ -37,6 +39,7 @@ VideoRenderer::VideoRenderer(QWidget* parent)
 void VideoRenderer::copyDirectUrl()
 {
     auto reply = InnerTube::instance()->get<InnertubeEndpoints::Player>(videoId);
+    NetworkMetrics::instance()->track(reply, "Player");
     connect(reply, &InnertubeReply<InnertubeEndpoints::Player>::exception, this, [this] {
         QMessageBox::critical(this, "Failed to copy to clipboard", "Failed to copy the direct video URL to the clipboard. The video is likely unavailable.");
     });
@@ -106,9 +109,9 @@ void VideoRenderer::setData(const InnertubeObjects::CompactVideo& compactVideo,
     thumbnail->setProgress(progress, QTime(0, 0).secsTo(compactVideo.length()));
 
     if (useThumbnailFromData && !compactVideo.thumbnail.isEmpty())
-        setThumbnail(compactVideo.thumbnail.recommendedQuality(thumbnail->size())->url);
+        setThumbnail(compactVideo.thumbnail.recommendedQuality(thumbnail->size() * thumbnail->devicePixelRatioF())->url);
     else
-        setThumbnail("https://img.youtube.com/vi/" + videoId + "/mqdefault.jpg");
+        setThumbnail(TubeUtils::videoThumbnailUrl(videoId, thumbnail->width() * thumbnail->devicePixelRatioF()));
 
     QString title = QString(compactVideo.title.text).replace("\r\n", " ");
     watchPreloadData->title = title;
@@ -131,7 +134,7 @@ void VideoRenderer::setData(const InnertubeObjects::DisplayAd& displayAd,
     }
 
     thumbnail->setLengthText("Ad");
-    setThumbnail(displayAd.image.recommendedQuality(thumbnail->size())->url);
+    setThumbnail(displayAd.image.recommendedQuality(thumbnail->size() * thumbnail->devicePixelRatioF())->url);
 
     QString title = QString(displayAd.titleText.text).replace("\r\n", " ");
     titleLabel->setText(title);
@@ -169,9 +172,9 @@ void VideoRenderer::setData(const InnertubeObjects::LockupViewModel& lockup,
     thumbnail->setProgress(progress, QTime(0, 0).secsTo(lockup.length()));
 
     if (useThumbnailFromData && !lockup.contentImage.image.isEmpty())
-        setThumbnail(lockup.contentImage.image.recommendedQuality(thumbnail->size())->url);
+        setThumbnail(lockup.contentImage.image.recommendedQuality(thumbnail->size() * thumbnail->devicePixelRatioF())->url);
     else
-        setThumbnail("https://img.youtube.com/vi/" + videoId + "/mqdefault.jpg");
+        setThumbnail(TubeUtils::videoThumbnailUrl(videoId, thumbnail->width() * thumbnail->devicePixelRatioF()));
 
     QString title = QString(lockup.metadata.title).replace("\r\n", " ");
     watchPreloadData->title = title;
@@ -195,9 +198,9 @@ void VideoRenderer::setData(const InnertubeObjects::Reel& reel,
         thumbnail->setFixedSize(105, 186);
 
     if (useThumbnailFromData && !reel.thumbnail.isEmpty())
-        setThumbnail(reel.thumbnail.recommendedQuality(thumbnail->size())->url);
+        setThumbnail(reel.thumbnail.recommendedQuality(thumbnail->size() * thumbnail->devicePixelRatioF())->url);
     else
-        setThumbnail("https://img.youtube.com/vi/" + videoId + "/mqdefault.jpg");
+        setThumbnail(TubeUtils::videoThumbnailUrl(videoId, thumbnail->width() * thumbnail->devicePixelRatioF()));
 
     QString title = QString(reel.headline).replace("\r\n", " ");
     titleLabel->setText(title);
@@ -222,9 +225,9 @@ void VideoRenderer::setData(const InnertubeObjects::ShortsLockupViewModel& short
         thumbnail->setFixedSize(105, 186);
 
     if (useThumbnailFromData && !shortsLockup.thumbnail.isEmpty())
-        setThumbnail(shortsLockup.thumbnail.recommendedQuality(thumbnail->size())->url);
+        setThumbnail(shortsLockup.thumbnail.recommendedQuality(thumbnail->size() * thumbnail->devicePixelRatioF())->url);
     else
-        setThumbnail("https://img.youtube.com/vi/" + videoId + "/mqdefault.jpg");
+        setThumbnail(TubeUtils::videoThumbnailUrl(videoId, thumbnail->width() * thumbnail->devicePixelRatioF()));
 
     QString title = QString(shortsLockup.primaryText).replace("\r\n", " ");
     titleLabel->setText(title);
@@ -257,9 +260,9 @@ void VideoRenderer::setData(const InnertubeObjects::Video& video,
     thumbnail->setProgress(progress, QTime(0, 0).secsTo(video.length()));
 
     if (useThumbnailFromData && !video.thumbnail.isEmpty())
-        setThumbnail(video.thumbnail.recommendedQuality(thumbnail->size())->url);
+        setThumbnail(video.thumbnail.recommendedQuality(thumbnail->size() * thumbnail->devicePixelRatioF())->url);
     else
-        setThumbnail("https://img.youtube.com/vi/" + videoId + "/mqdefault.jpg");
+        setThumbnail(TubeUtils::videoThumbnailUrl(videoId, thumbnail->width() * thumbnail->devicePixelRatioF()));
 
     QString title = QString(video.title.text).replace("\r\n", " ");
     titleLabel->setText(title);
@@ -308,9 +311,9 @@ void VideoRenderer::setData(const InnertubeObjects::VideoDisplayButtonGroup& vid
     }
 
     if (useThumbnailFromData && !video.thumbnail.isEmpty())
-        setThumbnail(video.thumbnail.recommendedQuality(thumbnail->size())->url);
+        setThumbnail(video.thumbnail.recommendedQuality(thumbnail->size() * thumbnail->devicePixelRatioF())->url);
     else
-        setThumbnail("https://img.youtube.com/vi/" + videoId + "/mqdefault.jpg");
+        setThumbnail(TubeUtils::videoThumbnailUrl(videoId, thumbnail->width() * thumbnail->devicePixelRatioF()));
 
     QString title = QString(video.title.text).replace("\r\n", " ");
     watchPreloadData->title = title;
@@ -322,7 +325,7 @@ void VideoRenderer::setDeArrowData(const QString& thumbFallbackUrl, const HttpRe
 {
     if (!reply.isSuccessful())
     {
-        thumbnail->setUrl(thumbFallbackUrl);
+        thumbnail->setUrl(thumbFallbackUrl, thumbnailPlaceholderUrl());
         return;
     }
 
@@ -347,19 +350,20 @@ void VideoRenderer::setDeArrowData(const QString& thumbFallbackUrl, const HttpRe
     if (qtTubeApp->settings().deArrowThumbs && validReplacement(thumbs))
         thumbnail->setUrl(QStringLiteral("https://dearrow-thumb.ajay.app/api/v1/getThumbnail?videoID=%1&timestamp=%2").arg(videoId).arg(thumbs[0]["timestamp"].toDouble()));
     else
-        thumbnail->setUrl(thumbFallbackUrl);
+        thumbnail->setUrl(thumbFallbackUrl, thumbnailPlaceholderUrl());
 }
 
 void VideoRenderer::setThumbnail(const QString& url)
 {
     if (qtTubeApp->settings().deArrow)
     {
-        HttpReply* arrowReply = Http::instance().get("https://sponsor.ajay.app/api/branding?videoID=" + videoId);
+        HttpReply* arrowReply = HttpUtils::get(
+            "https://sponsor.ajay.app/api/branding?videoID=" + videoId, false, RequestPriority::Visible, this);
         connect(arrowReply, &HttpReply::finished, this, std::bind_front(&VideoRenderer::setDeArrowData, this, url));
     }
     else
     {
-        thumbnail->setUrl(url);
+        thumbnail->setUrl(url, thumbnailPlaceholderUrl());
     }
 }
 
@@ -377,3 +381,8 @@ void VideoRenderer::showTitleContextMenu(const QPoint& pos)
     menu->addAction(copyDirectAction);
     menu->popup(titleLabel->mapToGlobal(pos));
 }
+
+QString VideoRenderer::thumbnailPlaceholderUrl() const
+{
+    return !videoId.isEmpty() ? TubeUtils::videoThumbnailUrl(videoId) : QString();
+}
@@ -50,6 +50,7 @@ private:
     std::unique_ptr<PreloadData::WatchView> watchPreloadData;
 
     void setThumbnail(const QString& url);
+    QString thumbnailPlaceholderUrl() const;
 private slots:
     void copyDirectUrl();
     void copyVideoUrl();
@@ -1,7 +1,11 @@
 #include "videothumbnailwidget.h"
-#include "http.h"
+#include "utils/httputils.h"
+#include "utils/tracing.h"
+#include "utils/tubeutils.h"
 #include <QProgressBar>
+#include <QTimer>
 
+constexpr int UpgradeDelay = 300;
 constexpr QLatin1String LengthStylesheet("background: rgba(0, 0, 0, 0.75); color: #fff; padding: 0 1px");
 constexpr QLatin1String ProgressStylesheet(R"(
     QProgressBar { background-color: #717171; }
@@ -9,7 +13,10 @@ constexpr QLatin1String ProgressStylesheet(R"(
 )");
 
 VideoThumbnailWidget::VideoThumbnailWidget(QWidget* parent)
-    : ClickableWidget<QLabel>(parent), m_lengthLabel(new QLabel(this)), m_progressBar(new QProgressBar(this))
+    : ClickableWidget<QLabel>(parent),
+      m_lengthLabel(new QLabel(this)),
+      m_progressBar(new QProgressBar(this)),
+      m_upgradeTimer(new QTimer(this))
 {
     setClickable(true);
     setMinimumSize(1, 1);
@@ -22,6 +29,74 @@ VideoThumbnailWidget::VideoThumbnailWidget(QWidget* parent)
     m_progressBar->hide();
     m_progressBar->setFixedHeight(3);
     m_progressBar->setStyleSheet(ProgressStylesheet);
+
+    m_upgradeTimer->setInterval(UpgradeDelay);
+    m_upgradeTimer->setSingleShot(true);
+    connect(m_upgradeTimer, &QTimer::timeout, this, &VideoThumbnailWidget::upgrade);
+}
+
+void VideoThumbnailWidget::fetch(const QString& url, bool isUpgrade)
+{
+    // upgrades are only asked for while on screen, so they don't need to wait on the owning list like everything else.
+    // cached so that feeds painted from a snapshot (see FeedSnapshots) get their thumbnails from disk as well.
+    quint64 traceId = Tracing::asyncBegin("thumbnail", "network");
+    HttpReply* reply = HttpUtils::get(url, true, RequestPriority::Visible, isUpgrade ? nullptr : this);
+    connect(reply, &HttpReply::finished, this, [this, isUpgrade, traceId](const HttpReply& reply) {
+        Tracing::asyncEnd("thumbnail", traceId, "network");
+
+        if (isUpgrade)
+        {
+            // not every video has every size (older ones often lack sddefault and hq720),
+            // and the next one down is still a lot better than the placeholder
+            if (reply.statusCode() != 200)
+            {
+                if (const QString smaller = TubeUtils::smallerVideoThumbnailUrl(reply.url().toString()); !smaller.isEmpty())
+                    fetch(smaller, true);
+                return;
+            }
+
+            m_upgraded = true;
+        }
+        else if (m_upgraded)
+        {
+            // the placeholder can lose the race against the real thing, don't let it replace it
+            return;
+        }
+
+        setData(reply);
+    });
+}
+
+// list items only get painted while they're in the viewport, which makes this a cheap way to notice being on screen
+void VideoThumbnailWidget::paintEvent(QPaintEvent* event)
+{
+    ClickableWidget<QLabel>::paintEvent(event);
+    if (m_released)
+        reload();
+    if (!m_upgradeUrl.isEmpty() && !m_upgradeTimer->isActive())
+        m_upgradeTimer->start();
+}
+
+void VideoThumbnailWidget::releasePixmap()
+{
+    if (m_shownUrl.isEmpty())
+        return;
+
+    clear();
+    m_released = true;
+}
+
+void VideoThumbnailWidget::reload()
+{
+    m_released = false;
+
+    // like upgrades, this only happens while on screen, so there's no need to wait on the owning list
+    HttpReply* reply = HttpUtils::get(m_shownUrl, true, RequestPriority::Visible);
+    connect(reply, &HttpReply::finished, this, [this](const HttpReply& reply) {
+        // something newer may have been shown since
+        if (reply.url() == m_shownUrl)
+            setData(reply);
+    });
 }
 
 void VideoThumbnailWidget::resizeEvent(QResizeEvent* event)
@@ -40,9 +115,20 @@ void VideoThumbnailWidget::setData(const HttpReply& reply)
     if (reply.statusCode() != 200)
         return;
 
+    Tracing::Span span("VideoThumbnailWidget::decode", "render");
     QPixmap pixmap;
     pixmap.loadFromData(reply.body());
+
+    // the 4:3 variants are letterboxed, so cut the bars off when they're going into a 16:9 space
+    if (pixmap.width() * 3 == pixmap.height() * 4 && width() * 2 > height() * 3)
+    {
+        const int contentHeight = pixmap.width() * 9 / 16;
+        pixmap = pixmap.copy(0, (pixmap.height() - contentHeight) / 2, pixmap.width(), contentHeight);
+    }
+
     setPixmap(pixmap);
+    m_released = false;
+    m_shownUrl = reply.url();
     emit thumbnailSet();
 }
 
@@ -52,8 +138,28 @@ void VideoThumbnailWidget::setProgress(int progress, int length)
     m_progressBar->setValue(progress);
 }
 
-void VideoThumbnailWidget::setUrl(const QString& url)
+void VideoThumbnailWidget::setUrl(const QString& url, const QString& placeholderUrl)
 {
-    HttpReply* reply = Http::instance().get(url);
-    connect(reply, &HttpReply::finished, this, &VideoThumbnailWidget::setData);
+    m_upgraded = false;
+    m_upgradeTimer->stop();
+
+    if (!placeholderUrl.isEmpty() && placeholderUrl != url)
+    {
+        m_upgradeUrl = url;
+        fetch(placeholderUrl, false);
+    }
+    else
+    {
+        m_upgradeUrl.clear();
+        fetch(url, false);
+    }
+}
+
+void VideoThumbnailWidget::upgrade()
+{
+    // scrolled past without stopping, wait for the next paint
+    if (visibleRegion().isEmpty())
+        return;
+
+    fetch(std::exchange(m_upgradeUrl, QString()), true);
 }
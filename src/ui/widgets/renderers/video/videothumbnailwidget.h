@@ -1,25 +1,40 @@
 #pragma once
 #include "ui/widgets/clickablewidget.h"
 #include <QLabel>
+#include <QUrl>
 
 class HttpReply;
 class QProgressBar;
+class QTimer;
 
 class VideoThumbnailWidget : public ClickableWidget<QLabel>
 {
     Q_OBJECT
 public:
     explicit VideoThumbnailWidget(QWidget* parent = nullptr);
+    // drops the image while its view is kept around offscreen. it's fetched again (from cache) once it's painted.
+    void releasePixmap();
     void setLengthText(const QString& text) { m_lengthLabel->setText(text); }
     void setProgress(int progress, int length);
-    void setUrl(const QString& url);
+    // if placeholderUrl is given, that's shown first and url is only fetched once the thumbnail has stayed on screen for a bit.
+    void setUrl(const QString& url, const QString& placeholderUrl = {});
 protected:
+    void paintEvent(QPaintEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
 private:
     QLabel* m_lengthLabel;
     QProgressBar* m_progressBar;
+    bool m_released{};
+    QUrl m_shownUrl;
+    bool m_upgraded{};
+    QTimer* m_upgradeTimer;
+    QString m_upgradeUrl;
+
+    void fetch(const QString& url, bool isUpgrade);
+    void reload();
 private slots:
     void setData(const HttpReply& reply);
+    void upgrade();
 signals:
     void thumbnailSet();
 };
@@ -1,9 +1,13 @@
 #include "searchbox.h"
 #include "extmenu.h"
 #include "exttoolbutton.h"
+#include "utils/searchsuggestions.h"
 #include "utils/uiutils.h"
+#include <QAbstractItemView>
 #include <QBoxLayout>
+#include <QCompleter>
 #include <QLineEdit>
+#include <QStringListModel>
 
 SearchBox::SearchBox(QWidget* parent)
     : QWidget(parent),
@@ -12,14 +16,16 @@ SearchBox::SearchBox(QWidget* parent)
       searchForm(new QLineEdit(this)),
       searchTypeActionLink(new QAction(UIUtils::iconThemed("link"), "Link/ID", this)),
       searchTypeActionQuery(new QAction(UIUtils::iconThemed("search"), "Query", this)),
-      searchTypeMenu(new ExtMenu(this))
+      searchTypeMenu(new ExtMenu(this)),
+      suggestionsCompleter(new QCompleter(this)),
+      suggestionsModel(new QStringListModel(this))
 {
     setFixedHeight(35);
     layout->setContentsMargins(0, 0, 0, 0);
     layout->setSpacing(0);
 
-    connect(searchTypeActionLink, &QAction::triggered, this, [this] { emit searchRequested(searchForm->text(), SearchType::ByLink); });
-    connect(searchTypeActionQuery, &QAction::triggered, this, [this] { emit searchRequested(searchForm->text(), SearchType::ByQuery); });
+    connect(searchTypeActionLink, &QAction::triggered, this, [this] { requestSearch(searchForm->text(), SearchType::ByLink); });
+    connect(searchTypeActionQuery, &QAction::triggered, this, [this] { requestSearch(searchForm->text(), SearchType::ByQuery); });
 
     searchTypeMenu->addAction(searchTypeActionQuery);
     searchTypeMenu->addAction(searchTypeActionLink);
@@ -36,16 +42,52 @@ SearchBox::SearchBox(QWidget* parent)
     searchForm->setFixedHeight(35);
     searchForm->setPlaceholderText("Search");
     connect(searchForm, &QLineEdit::returnPressed, this, [this] {
-        emit searchRequested(
+        requestSearch(
             searchForm->text(),
             searchButton->defaultAction() == searchTypeActionQuery ? SearchType::ByQuery : SearchType::ByLink
         );
     });
 
+    // the model is only ever what SearchSuggestions sent for the current text, so the completer shouldn't filter it again
+    suggestionsCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    suggestionsCompleter->setMaxVisibleItems(SearchSuggestions::MaxSuggestions);
+    suggestionsCompleter->setModel(suggestionsModel);
+    searchForm->setCompleter(suggestionsCompleter);
+
+    // picking with the keyboard goes through returnPressed, only clicks need handling here
+    connect(suggestionsCompleter->popup(), &QAbstractItemView::clicked, this, [this](const QModelIndex& index) {
+        requestSearch(index.data().toString(), SearchType::ByQuery);
+    });
+    connect(searchForm, &QLineEdit::textEdited, this, [this](const QString& text) {
+        if (searchButton->defaultAction() == searchTypeActionQuery)
+            SearchSuggestions::instance()->request(text);
+    });
+    connect(SearchSuggestions::instance(), &SearchSuggestions::ready, this, &SearchBox::showSuggestions);
+
     layout->addWidget(searchForm);
     layout->addWidget(searchButton);
 }
 
+void SearchBox::requestSearch(const QString& query, SearchType searchType)
+{
+    SearchSuggestions::instance()->cancel();
+    suggestionsCompleter->popup()->hide();
+    emit searchRequested(query, searchType);
+}
+
+void SearchBox::showSuggestions(const QString& text, const QStringList& suggestions)
+{
+    // anything for text the box has since moved on from is stale
+    if (text != searchForm->text() || !searchForm->hasFocus())
+        return;
+
+    suggestionsModel->setStringList(suggestions);
+    if (suggestions.isEmpty())
+        suggestionsCompleter->popup()->hide();
+    else
+        suggestionsCompleter->complete();
+}
+
 void SearchBox::updatePalette(const QPalette& pal)
 {
     setPalette(pal);
@@ -3,8 +3,10 @@
 
 class ExtMenu;
 class ExtToolButton;
+class QCompleter;
 class QHBoxLayout;
 class QLineEdit;
+class QStringListModel;
 
 class SearchBox : public QWidget
 {
@@ -20,6 +22,11 @@ private:
     QAction* searchTypeActionLink;
     QAction* searchTypeActionQuery;
     ExtMenu* searchTypeMenu;
+    QCompleter* suggestionsCompleter;
+    QStringListModel* suggestionsModel;
+
+    void requestSearch(const QString& query, SearchType searchType);
+    void showSuggestions(const QString& text, const QStringList& suggestions);
 signals:
     void searchRequested(const QString& query, SearchBox::SearchType searchType);
 };
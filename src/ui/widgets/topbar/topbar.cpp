@@ -7,12 +7,15 @@
 #include "qttubeapplication.h"
 #include "ui/forms/settings/settingsform.h"
 #include "utils/httputils.h"
+#include "utils/networkmetrics.h"
 #include "utils/uiutils.h"
 #include <QApplication>
 #include <QMouseEvent>
 #include <QPropertyAnimation>
 #include <QPushButton>
+#include <QScreen>
 #include <QTabBar>
+#include <QTimer>
 
 #ifdef INNERTUBE_NO_WEBENGINE
 #include <QMessageBox>
@@ -23,10 +26,12 @@ TopBar::TopBar(QWidget* parent)
       animation(new QPropertyAnimation(this, "geometry")),
       avatarButton(new TubeLabel(this)),
       logo(new TubeLabel(this)),
+      mouseMoveTimer(new QTimer(this)),
       notificationBell(new TopBarBell(this)),
       searchBox(new SearchBox(this)),
       settingsButton(new TubeLabel(this)),
-      signInButton(new QPushButton(this))
+      signInButton(new QPushButton(this)),
+      unseenCountTimer(new QTimer(this))
 {
     resize(parent->width(), 35);
     setAutoFillBackground(true);
@@ -35,6 +40,9 @@ TopBar::TopBar(QWidget* parent)
     animation->setDuration(250);
     animation->setEasingCurve(QEasingCurve::InOutQuint);
 
+    mouseMoveTimer->setSingleShot(true);
+    connect(mouseMoveTimer, &QTimer::timeout, this, &TopBar::processMouseMove);
+
     avatarButton->hide();
     avatarButton->move(673, 3);
     avatarButton->resize(30, 30);
@@ -61,17 +69,55 @@ TopBar::TopBar(QWidget* parent)
     signInButton->resize(80, 35);
     signInButton->setText("Sign in");
     connect(signInButton, &QPushButton::clicked, this, &TopBar::trySignIn);
+
+    unseenCountTimer->setInterval(UnseenCountPollInterval);
+    connect(unseenCountTimer, &QTimer::timeout, this, [this] { updateNotificationCount(); });
+}
+
+int TopBar::frameIntervalMs() const
+{
+    const QScreen* currentScreen = screen();
+    const qreal refreshRate = currentScreen && currentScreen->refreshRate() > 0 ? currentScreen->refreshRate() : 60;
+    return std::max(1, qRound(1000 / refreshRate));
+}
+
+// mouse moves come in far faster than anything can be drawn, so only act on the latest position once per frame.
+void TopBar::handleMouseMove(const QPoint& pos)
+{
+    pendingMousePos = pos;
+    if (mouseMoveTimer->isActive())
+        return;
+
+    const int frameInterval = frameIntervalMs();
+    if (!mouseMoveClock.isValid() || mouseMoveClock.elapsed() >= frameInterval)
+        processMouseMove();
+    else
+        mouseMoveTimer->start(static_cast<int>(frameInterval - mouseMoveClock.elapsed()));
+}
+
+void TopBar::postSignInSetup(bool emitSignal)
+{
+    avatarButton->show();
+    signInButton->hide();
+    setUpAvatarButton();
+    setUpNotifications();
+
+    if (emitSignal)
+        emit signInStatusChanged();
 }
 
-void TopBar::handleMouseEvent(QMouseEvent* event)
+void TopBar::processMouseMove()
 {
+    mouseMoveClock.restart();
+    ++numProcessedMouseMoves;
+
     bool interferingWithTab{};
     if (QWidget* widgetAtPoint = qApp->widgetAt(QCursor::pos()))
         interferingWithTab = strncmp(widgetAtPoint->metaObject()->className(), "QTab", 4) == 0;
     if (alwaysShow || animation->state() == QAbstractAnimation::Running || interferingWithTab)
         return;
 
-    if (event->pos().y() < height())
+    if (pendingMousePos.y() < height())
     {
         if (isHidden())
         {
@@ -94,17 +140,6 @@ void TopBar::handleMouseEvent(QMouseEvent* event)
     }
 }
 
-void TopBar::postSignInSetup(bool emitSignal)
-{
-    avatarButton->show();
-    signInButton->hide();
-    setUpAvatarButton();
-    setUpNotifications();
-
-    if (emitSignal)
-        emit signInStatusChanged();
-}
-
 void TopBar::scaleAppropriately()
 {
     if (InnerTube::instance()->hasAuthenticated())
@@ -132,14 +167,22 @@ void TopBar::setAvatar(const HttpReply& reply)
 void TopBar::setUpAvatarButton()
 {
     scaleAppropriately();
+
+    if (const CredentialSet* activeLogin = qtTubeApp->creds().activeLogin(); activeLogin && !activeLogin->avatarUrl.isEmpty())
+    {
+        HttpReply* cachedReply = HttpUtils::get(activeLogin->avatarUrl, true);
+        connect(cachedReply, &HttpReply::finished, this, &TopBar::setAvatar);
+    }
+
     auto reply = InnerTube::instance()->get<InnertubeEndpoints::AccountMenu>();
+    NetworkMetrics::instance()->track(reply, "AccountMenu");
     connect(reply, &InnertubeReply<InnertubeEndpoints::AccountMenu>::finished, this, [this](const InnertubeEndpoints::AccountMenu& endpoint)
     {
         qtTubeApp->creds().updateAccount(endpoint);
         if (const InnertubeObjects::GenericThumbnail* recAvatar =
             endpoint.response.header.accountPhoto.recommendedQuality(avatarButton->size()))
         {
-            HttpReply* photoReply = HttpUtils::cachedInstance().get(recAvatar->url);
+            HttpReply* photoReply = HttpUtils::get(recAvatar->url, true);
             connect(photoReply, &HttpReply::finished, this, &TopBar::setAvatar);
         }
     });
@@ -149,8 +192,17 @@ void TopBar::setUpNotifications()
 {
     scaleAppropriately();
     notificationBell->setVisible(InnerTube::instance()->hasAuthenticated());
+    unseenCount = -1;
+
     if (InnerTube::instance()->hasAuthenticated())
+    {
         updateNotificationCount();
+        unseenCountTimer->start();
+    }
+    else
+    {
+        unseenCountTimer->stop();
+    }
 }
 
 void TopBar::showSettings()
@@ -206,16 +258,20 @@ void TopBar::updateNotificationCount(int value)
 {
     if (value >= 0) // if value is non-negative (default value is -1)
     {
+        unseenCount = value;
         notificationBell->updatePixmap(value > 0, palette());
         notificationBell->updateCount(value);
     }
     else
     {
         auto reply = InnerTube::instance()->get<InnertubeEndpoints::UnseenCount>();
+        NetworkMetrics::instance()->track(reply, "UnseenCount");
         connect(reply, &InnertubeReply<InnertubeEndpoints::UnseenCount>::finished, this, [this](const InnertubeEndpoints::UnseenCount& endpoint)
         {
             notificationBell->updatePixmap(endpoint.unseenCount > 0, palette());
             notificationBell->updateCount(endpoint.unseenCount);
+            if (std::exchange(unseenCount, endpoint.unseenCount) != endpoint.unseenCount)
+                emit unseenCountChanged(endpoint.unseenCount);
         });
     }
 }
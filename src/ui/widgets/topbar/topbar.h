@@ -2,22 +2,29 @@
 #include "searchbox.h"
 #include "topbarbell.h"
 #include "ui/widgets/labels/tubelabel.h"
+#include <QElapsedTimer>
 
 class HttpReply;
 class QPropertyAnimation;
 class QPushButton;
+class QTimer;
 
 class TopBar : public QWidget
 {
     Q_OBJECT
 public:
+    static constexpr int UnseenCountPollInterval = 180000;
+
     TubeLabel* avatarButton;
     TubeLabel* logo;
     TopBarBell* notificationBell;
     SearchBox* searchBox;
 
     explicit TopBar(QWidget* parent);
-    void handleMouseEvent(QMouseEvent* event);
+    void handleMouseMove(const QPoint& pos);
+    bool isAlwaysShown() const { return alwaysShow; }
+    // mouse moves that made it past the once-per-frame throttle, for --benchmark
+    int mouseMovesProcessed() const { return numProcessedMouseMoves; }
     void postSignInSetup(bool emitSignal = true);
     void scaleAppropriately();
     void setAlwaysShow(bool alwaysShow) { this->alwaysShow = alwaysShow; }
@@ -25,17 +32,27 @@ public:
 private:
     bool alwaysShow = true;
     QPropertyAnimation* animation;
+    QElapsedTimer mouseMoveClock;
+    QTimer* mouseMoveTimer;
+    int numProcessedMouseMoves{};
+    QPoint pendingMousePos;
     TubeLabel* settingsButton;
     QPushButton* signInButton;
+    int unseenCount = -1;
+    QTimer* unseenCountTimer;
+
+    int frameIntervalMs() const;
 public slots:
     void signOut();
     void trySignIn();
     void updateNotificationCount(int value = -1);
 private slots:
+    void processMouseMove();
     void setAvatar(const HttpReply& reply);
     void setUpAvatarButton();
     void setUpNotifications();
     void showSettings();
 signals:
     void signInStatusChanged();
+    void unseenCountChanged(int count);
 };
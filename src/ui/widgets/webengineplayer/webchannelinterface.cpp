@@ -31,6 +31,15 @@ void WebChannelInterface::handleShare(const QString& href)
 
 void WebChannelInterface::handleStateChange(PlayerState state)
 {
+    // a suspended player belongs to a view that isn't showing, so it mustn't touch the title or idle sleep.
+    // it can still start playing by itself if it was suspended before the page loaded.
+    if (m_suspended)
+    {
+        if (state == STATE_PLAYING)
+            emit playedWhileSuspended();
+        return;
+    }
+
     switch (state)
     {
     case STATE_PLAYING:
@@ -50,6 +59,10 @@ void WebChannelInterface::handleStateChange(PlayerState state)
 
 void WebChannelInterface::setWindowTitleSuffix(const QString& suffix)
 {
+    // players in suspended views still report being paused, but the title belongs to whatever's showing now
+    if (QWidget* player = qobject_cast<QWidget*>(parent()); player && !player->isVisible())
+        return;
+
     if (QMainWindow* mainWindow = UIUtils::getMainWindow())
     {
         static QRegularExpression suffixRegex(R"( \[(Playing|Paused)\]$)");
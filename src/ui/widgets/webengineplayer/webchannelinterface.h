@@ -21,8 +21,13 @@ public:
     Q_INVOKABLE void handleShare(const QString& href);
     Q_INVOKABLE void handleStateChange(PlayerState state);
     Q_INVOKABLE void switchWatchViewVideo(const QString& videoId);
+
+    void setSuspended(bool suspended) { m_suspended = suspended; }
 private:
+    bool m_suspended{};
+
     void setWindowTitleSuffix(const QString& suffix);
 signals:
+    void playedWhileSuspended();
     void progressChanged(double progress, double previousProgress);
 };
@@ -5,8 +5,10 @@
 #include "webchannelinterface.h"
 #include <QBoxLayout>
 #include <QFile>
+#include <QStandardPaths>
 #include <QWebChannel>
 #include <QWebEngineCookieStore>
+#include <QWebEnginePage>
 #include <QWebEngineProfile>
 #include <QWebEngineScriptCollection>
 #include <QWebEngineSettings>
@@ -17,6 +19,8 @@ WebEnginePlayer::WebEnginePlayer(QWidget* parent)
       m_interface(new WebChannelInterface(this)),
       m_view(new QWebEngineView(this))
 {
+    m_view->setPage(new QWebEnginePage(profile(), m_view));
+
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->addWidget(m_view);
     layout->setContentsMargins(0, 0, 0, 0);
@@ -26,27 +30,31 @@ WebEnginePlayer::WebEnginePlayer(QWidget* parent)
     channel->registerObject("settings", &qtTubeApp->settings());
     m_view->page()->setWebChannel(channel);
 
-    loadScriptFile(":/qtwebchannel/qwebchannel.js", QWebEngineScript::DocumentCreation);
-    loadScriptFile(":/player/annotationlib/AnnotationParser.js", QWebEngineScript::DocumentReady);
-    loadScriptFile(":/player/annotationlib/AnnotationRenderer.js", QWebEngineScript::DocumentReady);
-    loadScriptFile(":/player/annotations.js", QWebEngineScript::DocumentReady);
-    loadScriptFile(":/player/global.js", QWebEngineScript::DocumentCreation);
-    loadScriptFile(":/player/h264ify.js", QWebEngineScript::DocumentReady);
-    loadScriptFile(":/player/integration.js", QWebEngineScript::DocumentReady);
-    loadScriptFile(":/player/interceptors.js", QWebEngineScript::DocumentCreation);
-    loadScriptFile(":/player/sponsorblock.js", QWebEngineScript::DocumentReady);
-
-    QString annotationStylesData = getFileContents(":/player/annotationlib/AnnotationRenderer.css");
-    QString patchesData = getFileContents(":/player/patches.js");
-    QString stylesData = getFileContents(":/player/styles.css");
-    loadScriptString(patchesData.arg(annotationStylesData + stylesData), QWebEngineScript::DocumentReady);
+    m_view->page()->scripts().insert(scripts());
 
-    m_view->page()->profile()->setUrlRequestInterceptor(m_interceptor);
     m_view->settings()->setAttribute(QWebEngineSettings::FullScreenSupportEnabled, true);
     m_view->settings()->setAttribute(QWebEngineSettings::PlaybackRequiresUserGesture, false);
 
+    connect(m_interface, &WebChannelInterface::playedWhileSuspended, this, &WebEnginePlayer::suspend);
     connect(m_interface, &WebChannelInterface::progressChanged, this, &WebEnginePlayer::progressChanged);
     connect(m_view->page(), &QWebEnginePage::fullScreenRequested, this, &WebEnginePlayer::fullScreenRequested);
+    connect(m_view->page(), &QWebEnginePage::loadFinished, this, &WebEnginePlayer::measureCacheUsage);
+}
+
+WebEnginePlayer* WebEnginePlayer::acquire(QWidget* parent)
+{
+    WebEnginePlayer* player = m_warmPlayer ? m_warmPlayer.data() : new WebEnginePlayer;
+    m_warmPlayer.clear();
+    player->setParent(parent);
+    player->activate();
+    return player;
+}
+
+void WebEnginePlayer::activate()
+{
+    // the interceptor lives on the shared profile, so whoever is active has to claim it
+    m_view->page()->profile()->setUrlRequestInterceptor(m_interceptor);
+    m_interface->setSuspended(false);
 }
 
 void WebEnginePlayer::fullScreenRequested(QWebEngineFullScreenRequest request)
@@ -65,18 +73,28 @@ QString WebEnginePlayer::getFileContents(const QString& path)
     return file.readAll();
 }
 
-void WebEnginePlayer::loadScriptFile(const QString& path, QWebEngineScript::InjectionPoint injectionPoint)
-{
-    loadScriptString(getFileContents(path), injectionPoint);
-}
-
-void WebEnginePlayer::loadScriptString(const QString& data, QWebEngineScript::InjectionPoint injectionPoint)
+QWebEngineScript WebEnginePlayer::makeScript(const QString& data, QWebEngineScript::InjectionPoint injectionPoint)
 {
     QWebEngineScript script;
     script.setInjectionPoint(injectionPoint);
     script.setSourceCode(data);
     script.setWorldId(QWebEngineScript::MainWorld);
-    m_view->page()->scripts().insert(script);
+    return script;
+}
+
+void WebEnginePlayer::measureCacheUsage(bool ok)
+{
+    if (!ok || m_view->url().scheme() == "about")
+        return;
+
+    // webengine doesn't report cache hits, but resources served from the http cache have a transfer size of 0
+    m_view->page()->runJavaScript(R"(
+        performance.getEntriesByType("resource")
+            .filter(e => e.transferSize === 0 && e.decodedBodySize > 0)
+            .reduce((sum, e) => sum + e.decodedBodySize, 0)
+    )", [](const QVariant& result) {
+        m_cacheBytesServed += result.toLongLong();
+    });
 }
 
 void WebEnginePlayer::play(const QString& vId, int progress)
@@ -91,6 +109,90 @@ void WebEnginePlayer::play(const QString& vId, int progress)
                           .arg(qtTubeApp->settings().blockAds)));
 }
 
+void WebEnginePlayer::playTestPage(int progress)
+{
+    // the same parameters play() passes, with everything that would change how the page loads turned off
+    m_view->load(QUrl(QStringLiteral("qrc:/player/testpage.html?t=%1&h264Only=0&no60Fps=0&adblock=0").arg(progress)));
+}
+
+void WebEnginePlayer::prewarm()
+{
+    if (m_warmPlayer)
+        return;
+
+    // loading a blank page is enough to get the renderer process up
+    m_warmPlayer = new WebEnginePlayer;
+    m_warmPlayer->m_view->setUrl(QUrl("about:blank"));
+}
+
+QWebEngineProfile* WebEnginePlayer::profile()
+{
+    // intentionally never deleted, pages must all be gone before their profile is
+    static QWebEngineProfile* profile = [] {
+        QWebEngineProfile* profile = new QWebEngineProfile("player");
+        profile->setCachePath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/player");
+        profile->setHttpCacheMaximumSize(HttpCacheMaxSize);
+        profile->setHttpCacheType(QWebEngineProfile::DiskHttpCache);
+        // auth cookies get set from the auth store every time, don't leave them lying around on disk
+        profile->setPersistentCookiesPolicy(QWebEngineProfile::NoPersistentCookies);
+        return profile;
+    }();
+    return profile;
+}
+
+void WebEnginePlayer::release(WebEnginePlayer* player)
+{
+    if (!player)
+        return;
+
+    if (m_warmPlayer && m_warmPlayer != player)
+    {
+        player->deleteLater();
+        return;
+    }
+
+    player->reset();
+    player->setParent(nullptr);
+    m_warmPlayer = player;
+}
+
+void WebEnginePlayer::reset()
+{
+    disconnect(this, &WebEnginePlayer::progressChanged, nullptr, nullptr);
+    m_fullScreenWindow.reset();
+    m_view->setUrl(QUrl("about:blank"));
+    setMinimumSize(0, 0);
+    setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+}
+
+const QList<QWebEngineScript>& WebEnginePlayer::scripts()
+{
+    static const QList<QWebEngineScript> scripts = [] {
+        QString annotationStylesData = getFileContents(":/player/annotationlib/AnnotationRenderer.css");
+        QString patchesData = getFileContents(":/player/patches.js");
+        QString stylesData = getFileContents(":/player/styles.css");
+
+        return QList<QWebEngineScript> {
+            makeScript(getFileContents(":/qtwebchannel/qwebchannel.js"), QWebEngineScript::DocumentCreation),
+            makeScript(getFileContents(":/player/annotationlib/AnnotationParser.js"), QWebEngineScript::DocumentReady),
+            makeScript(getFileContents(":/player/annotationlib/AnnotationRenderer.js"), QWebEngineScript::DocumentReady),
+            makeScript(getFileContents(":/player/annotations.js"), QWebEngineScript::DocumentReady),
+            makeScript(getFileContents(":/player/global.js"), QWebEngineScript::DocumentCreation),
+            makeScript(getFileContents(":/player/h264ify.js"), QWebEngineScript::DocumentReady),
+            makeScript(getFileContents(":/player/integration.js"), QWebEngineScript::DocumentReady),
+            makeScript(getFileContents(":/player/interceptors.js"), QWebEngineScript::DocumentCreation),
+            makeScript(getFileContents(":/player/sponsorblock.js"), QWebEngineScript::DocumentReady),
+            makeScript(patchesData.arg(annotationStylesData + stylesData), QWebEngineScript::DocumentReady)
+        };
+    }();
+    return scripts;
+}
+
+void WebEnginePlayer::seek(int progress)
+{
+    m_view->page()->runJavaScript(QStringLiteral("document.getElementById('movie_player').seekTo(%1);").arg(progress));
+}
+
 void WebEnginePlayer::setAuthStore(InnertubeAuthStore* authStore)
 {
     m_interceptor->setAuthStore(authStore);
@@ -123,12 +225,15 @@ void WebEnginePlayer::setPlayerResponse(const InnertubeEndpoints::PlayerResponse
     m_interceptor->setPlayerResponse(resp);
 }
 
-void WebEnginePlayer::seek(int progress)
+void WebEnginePlayer::showSharePanel()
 {
-    m_view->page()->runJavaScript(QStringLiteral("document.getElementById('movie_player').seekTo(%1);").arg(progress));
+    m_view->page()->runJavaScript("document.querySelector('.ytp-share-button').click()");
 }
 
-void WebEnginePlayer::showSharePanel()
+void WebEnginePlayer::suspend()
 {
-    m_view->page()->runJavaScript("document.querySelector('.ytp-share-button').click()");
+    // the player may not be up yet if the page is still loading. it autoplays once it is,
+    // which the interface catches and sends back here.
+    m_interface->setSuspended(true);
+    m_view->page()->runJavaScript(QStringLiteral("document.getElementById('movie_player')?.pauseVideo();"));
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <QPointer>
 #include <QWebEngineFullScreenRequest>
 #include <QWebEngineScript>
 #include <QWidget>
@@ -10,6 +11,7 @@ class InnertubeAuthStore;
 struct InnertubeContext;
 class PlayerInterceptor;
 class QWebEngineFullScreenRequest;
+class QWebEngineProfile;
 class QWebEngineView;
 class WebChannelInterface;
 
@@ -18,24 +20,48 @@ class WebEnginePlayer : public QWidget
     Q_OBJECT
 public:
     explicit WebEnginePlayer(QWidget* parent = nullptr);
+    // claims the shared profile's request interceptor. acquire() does this, so the warm player never takes it from
+    // the one playing. players kept in navigation history need it back when they're shown again.
+    void activate();
     void setAuthStore(InnertubeAuthStore* authStore);
     void setContext(InnertubeContext* context);
     void setPlayerResponse(const InnertubeEndpoints::PlayerResponse& resp);
     void showSharePanel();
+
+    // the pool holds at most one warm, hidden player. acquire() hands it out (or makes a new one),
+    // release() takes a player back once its owner is done with it.
+    static WebEnginePlayer* acquire(QWidget* parent);
+    static void prewarm();
+    static void release(WebEnginePlayer* player);
+
+    // all players share one on-disk profile so player assets are served from cache across loads.
+    static qint64 cacheBytesServed() { return m_cacheBytesServed; }
+    static QWebEngineProfile* profile();
 private:
+    static constexpr int HttpCacheMaxSize = 256 * 1024 * 1024;
+    static inline qint64 m_cacheBytesServed{};
+    static inline QPointer<WebEnginePlayer> m_warmPlayer;
+
     std::unique_ptr<FullScreenWindow> m_fullScreenWindow;
     PlayerInterceptor* m_interceptor;
     WebChannelInterface* m_interface;
     QWebEngineView* m_view;
 
-    QString getFileContents(const QString& path);
-    void loadScriptFile(const QString& path, QWebEngineScript::InjectionPoint injectionPoint);
-    void loadScriptString(const QString& data, QWebEngineScript::InjectionPoint injectionPoint);
+    void reset();
+
+    static QString getFileContents(const QString& path);
+    static QWebEngineScript makeScript(const QString& data, QWebEngineScript::InjectionPoint injectionPoint);
+    static const QList<QWebEngineScript>& scripts();
 public slots:
     void play(const QString& vId, int progress);
+    // loads the bundled stand-in for the embed page instead of a video, for --benchmark
+    void playTestPage(int progress);
     void seek(int progress);
+    // pauses, and keeps the player paused and its state unreported until activate(). for players kept in navigation history.
+    void suspend();
 private slots:
     void fullScreenRequested(QWebEngineFullScreenRequest request);
+    void measureCacheUsage(bool ok);
 signals:
     void progressChanged(double progress, double previousProgress);
 };
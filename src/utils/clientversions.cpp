@@ -0,0 +1,71 @@
+#include "clientversions.h"
+#include "localcache.h"
+#include <QThreadPool>
+
+namespace
+{
+    // web's version predates the others being cached, so it keeps its old key
+    QByteArray cacheKey(InnertubeClient::ClientType type)
+    {
+        return type == InnertubeClient::ClientType::WEB
+            ? QByteArrayLiteral("cver") : "cver-" + QByteArray::number(static_cast<int>(type));
+    }
+
+    LocalCache* clientCache()
+    {
+        LocalCache* cache = LocalCache::instance("client");
+        cache->setMaxSeconds(86400);
+        return cache;
+    }
+}
+
+ClientVersions* ClientVersions::instance()
+{
+    std::call_once(m_onceFlag, [] { m_instance = new ClientVersions; });
+    return m_instance;
+}
+
+QString ClientVersions::cached(InnertubeClient::ClientType type) const
+{
+    return QString::fromLatin1(clientCache()->value(cacheKey(type)));
+}
+
+void ClientVersions::get(InnertubeClient::ClientType type, QObject* context,
+                         const std::function<void(const QString&)>& callback)
+{
+    if (!context)
+        context = this;
+
+    if (const QString version = cached(type); !version.isEmpty())
+    {
+        if (callback)
+            QMetaObject::invokeMethod(context, [callback, version] { callback(version); }, Qt::QueuedConnection);
+        return;
+    }
+
+    if (auto it = m_waiting.find(static_cast<int>(type)); it != m_waiting.end())
+    {
+        it->append(Waiter { callback, context });
+        return;
+    }
+
+    m_waiting.insert(static_cast<int>(type), { Waiter { callback, context } });
+
+    QThreadPool::globalInstance()->start([this, type] {
+        const QString version = InnertubeClient::getLatestVersion(type);
+        QMetaObject::invokeMethod(this, [this, type, version] { resolved(type, version); }, Qt::QueuedConnection);
+    });
+}
+
+void ClientVersions::resolved(InnertubeClient::ClientType type, const QString& version)
+{
+    if (!version.isEmpty())
+        clientCache()->insert(cacheKey(type), version.toLatin1());
+    else
+        qWarning() << "Failed to look up the latest client version for client type" << static_cast<int>(type);
+
+    const QList<Waiter> waiters = m_waiting.take(static_cast<int>(type));
+    for (const Waiter& waiter : waiters)
+        if (waiter.callback && waiter.context)
+            QMetaObject::invokeMethod(waiter.context.data(), [callback = waiter.callback, version] { callback(version); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "innertube/itc-objects/innertubeclient.h"
+#include <functional>
+#include <mutex>
+#include <QHash>
+#include <QPointer>
+
+// looking up the latest version of a client is a blocking request, which used to hold up startup (and the
+// guest home feed). versions are now looked up on a worker thread, and kept for a day so most launches
+// don't need to look them up at all.
+class ClientVersions : public QObject
+{
+    Q_OBJECT
+public:
+    static ClientVersions* instance();
+    explicit ClientVersions(QObject* parent = nullptr) : QObject(parent) {}
+
+    // the last version looked up for type if it's still fresh, otherwise empty
+    QString cached(InnertubeClient::ClientType type) const;
+    // calls back with the latest version of type, or an empty string if it couldn't be looked up.
+    // the callback is always queued, and is dropped if context is destroyed first.
+    void get(InnertubeClient::ClientType type, QObject* context, const std::function<void(const QString&)>& callback);
+    // starts looking up the latest version of type if it isn't cached, for something that will want it later
+    void prefetch(InnertubeClient::ClientType type) { get(type, nullptr, {}); }
+private:
+    struct Waiter
+    {
+        std::function<void(const QString&)> callback;
+        QPointer<QObject> context;
+    };
+
+    static inline ClientVersions* m_instance;
+    static inline std::once_flag m_onceFlag;
+
+    QHash<int, QList<Waiter>> m_waiting; // by client type
+
+    void resolved(InnertubeClient::ClientType type, const QString& version);
+};
@@ -0,0 +1,129 @@
+#include "emojicache.h"
+#include "httputils.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QGuiApplication>
+#include <QStandardPaths>
+#include <QTextDocument>
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 1, 0)
+constexpr QLatin1String ResourceScheme("qttube-emoji");
+#endif
+
+EmojiCache* EmojiCache::instance()
+{
+    std::call_once(m_onceFlag, [] { m_instance = new EmojiCache; });
+    return m_instance;
+}
+
+EmojiCache::EmojiCache(QObject* parent) : QObject(parent)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 1, 0)
+    // an emoji that hasn't arrived yet would otherwise get the broken image icon
+    m_blank = QPixmap(Size, Size);
+    m_blank.fill(Qt::transparent);
+
+    // every text document asks here first, so the decoded pixmap is shared by all of them.
+    // anything that isn't an emoji falls through to the usual loading.
+    QTextDocument::setDefaultResourceProvider([this](const QUrl& url) -> QVariant {
+        if (url.scheme() != ResourceScheme)
+            return QVariant();
+        return QVariant::fromValue(m_pixmaps.value(url.toString(), m_blank));
+    });
+#else
+    // no resource provider to hook into before qt 6.1, so emojis go to disk and text documents load them from there
+    m_dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + "emojis";
+    QDir().mkpath(m_dir);
+#endif
+}
+
+QString EmojiCache::resourceUrl(const QString& url)
+{
+    const QString hash = QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex();
+#if QT_VERSION >= QT_VERSION_CHECK(6, 1, 0)
+    const QString resourceUrl = QString(ResourceScheme) + ':' + hash;
+#else
+    const QString path = m_dir + QDir::separator() + hash;
+    const QString resourceUrl = QUrl::fromLocalFile(path).toString();
+    if (!m_loaded.contains(url) && QFile::exists(path))
+        m_loaded.insert(url, true);
+#endif
+
+    if (!m_loaded.contains(url))
+    {
+        m_loaded.insert(url, false);
+
+        HttpReply* reply = HttpUtils::get(url, true);
+        connect(reply, &HttpReply::finished, this, [this, resourceUrl, url](const HttpReply& reply) {
+            if (reply.isSuccessful())
+            {
+                store(url, resourceUrl, reply.body());
+            }
+            else
+            {
+                m_loaded.remove(url); // so the next message to use it tries again
+                settle(url);
+            }
+        });
+    }
+
+    return resourceUrl;
+}
+
+void EmojiCache::store(const QString& url, const QString& resourceUrl, const QByteArray& data)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 1, 0)
+    QPixmap pixmap;
+    pixmap.loadFromData(data);
+
+    // scaled once here rather than every time a message paints it
+    const qreal dpr = qGuiApp->devicePixelRatio();
+    pixmap = pixmap.scaled(QSize(Size, Size) * dpr, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    pixmap.setDevicePixelRatio(dpr);
+    m_pixmaps.insert(resourceUrl, pixmap);
+#else
+    QFile file(QUrl(resourceUrl).toLocalFile());
+    if (!file.open(QFile::WriteOnly | QFile::Truncate))
+    {
+        qWarning() << "Failed to save emoji:" << file.errorString();
+        m_loaded.remove(url);
+        settle(url);
+        return;
+    }
+    file.write(data);
+    file.close();
+#endif
+
+    m_loaded.insert(url, true);
+    settle(url);
+}
+
+void EmojiCache::settle(const QString& url)
+{
+    const QList<Waiter> waiters = m_waiters.take(url);
+    for (const Waiter& waiter : waiters)
+        if (waiter.context)
+            waiter.callback();
+}
+
+void EmojiCache::whenLoaded(const QStringList& urls, QObject* context, std::function<void()>&& callback)
+{
+    // counts down as each one settles. a failed emoji won't show either way, but the ones that did land should
+    std::shared_ptr<qsizetype> remaining = std::make_shared<qsizetype>(0);
+    std::shared_ptr<std::function<void()>> shared = std::make_shared<std::function<void()>>(std::move(callback));
+    for (const QString& url : urls)
+    {
+        if (isLoaded(url))
+            continue;
+
+        ++*remaining;
+        m_waiters[url].append(Waiter { context, [remaining, shared] {
+            if (--*remaining == 0)
+                (*shared)();
+        } });
+    }
+
+    if (*remaining == 0)
+        (*shared)();
+}
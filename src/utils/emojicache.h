@@ -0,0 +1,47 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <QHash>
+#include <QObject>
+#include <QPixmap>
+#include <QPointer>
+
+// custom emojis get spammed in live chat, so each one is only fetched and decoded once and every message
+// using it points at it by the same url. messages reserve its size up front, so when it does arrive
+// nothing moves, they only need to set their text again (once, after the last of theirs) for it to be picked up.
+class EmojiCache : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int Size = 20;
+
+    static EmojiCache* instance();
+    explicit EmojiCache(QObject* parent = nullptr);
+
+    bool isLoaded(const QString& url) const { return m_loaded.value(url); }
+    // what rich text should use to show the emoji at url. starts fetching it if that hasn't happened yet.
+    QString resourceUrl(const QString& url);
+    // calls back once, after every emoji in urls has either been fetched or failed to be, unless context is gone by then.
+    void whenLoaded(const QStringList& urls, QObject* context, std::function<void()>&& callback);
+private:
+    struct Waiter
+    {
+        QPointer<QObject> context;
+        std::function<void()> callback;
+    };
+
+    static inline EmojiCache* m_instance;
+    static inline std::once_flag m_onceFlag;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 1, 0)
+    QPixmap m_blank;
+    QHash<QString, QPixmap> m_pixmaps; // by resource url
+#else
+    QString m_dir;
+#endif
+    QHash<QString, bool> m_loaded; // by emoji url, false while it's being fetched
+    QHash<QString, QList<Waiter>> m_waiters; // by emoji url
+
+    void settle(const QString& url);
+    void store(const QString& url, const QString& resourceUrl, const QByteArray& data);
+};
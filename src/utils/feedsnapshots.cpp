@@ -0,0 +1,60 @@
+#include "feedsnapshots.h"
+#include "qttubeapplication.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+constexpr int MaxSnapshotAge = 3 * 86400;
+
+namespace FeedSnapshots
+{
+    namespace
+    {
+        QString snapshotPath(const QString& feed)
+        {
+            // feeds differ per account, and one account's shouldn't flash up for another
+            const CredentialSet* activeLogin = qtTubeApp->creds().activeLogin();
+            const QString owner = activeLogin ? activeLogin->channelId : QStringLiteral("guest");
+            return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                + "/snapshots/" + feed + '-' + owner + ".json.z";
+        }
+    }
+
+    QJsonValue load(const QString& feed)
+    {
+        QFile file(snapshotPath(feed));
+        if (QFileInfo(file).lastModified().secsTo(QDateTime::currentDateTime()) > MaxSnapshotAge)
+            return QJsonValue(QJsonValue::Undefined);
+        if (!file.open(QFile::ReadOnly))
+            return QJsonValue(QJsonValue::Undefined);
+
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(qUncompress(file.readAll()), &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject())
+            return QJsonValue(QJsonValue::Undefined);
+
+        return doc.object();
+    }
+
+    void save(const QString& feed, const QJsonValue& data)
+    {
+        const QString path = snapshotPath(feed);
+        QDir().mkpath(QFileInfo(path).absolutePath());
+
+        // written in full or not at all, a half-written snapshot would be worse than none
+        QSaveFile file(path);
+        if (!file.open(QFile::WriteOnly))
+        {
+            qWarning() << "Failed to save" << feed << "snapshot:" << file.errorString();
+            return;
+        }
+
+        file.write(qCompress(QJsonDocument(data.toObject()).toJson(QJsonDocument::Compact)));
+        if (!file.commit())
+            qWarning() << "Failed to save" << feed << "snapshot:" << file.errorString();
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <QJsonValue>
+
+// the last response for each of the main feeds, kept on disk so the feed can be painted straight away
+// and brought up to date in the background (stale-while-revalidate).
+// thumbnails aren't kept here, the image cache already has them under the same urls.
+namespace FeedSnapshots
+{
+    // returns undefined if there's no snapshot for the current account, or it's too old to be worth showing.
+    QJsonValue load(const QString& feed);
+    void save(const QString& feed, const QJsonValue& data);
+}
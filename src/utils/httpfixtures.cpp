@@ -0,0 +1,171 @@
+#include "httpfixtures.h"
+#include "http.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QTimer>
+
+namespace HttpFixtures
+{
+    namespace
+    {
+        class FixtureHttpReply : public HttpReply
+        {
+        public:
+            FixtureHttpReply(const QUrl& url, int statusCode, const QByteArray& body)
+                : m_body(body), m_statusCode(statusCode), m_url(url)
+            {
+                // finish on the next event loop iteration like a real reply would,
+                // so callers get a chance to connect first
+                QTimer::singleShot(0, this, [this] {
+                    emit finished(*this);
+                    deleteLater();
+                });
+            }
+
+            QByteArray body() const override { return m_body; }
+            int statusCode() const override { return m_statusCode; }
+            QUrl url() const override { return m_url; }
+        private:
+            QByteArray m_body;
+            int m_statusCode;
+            QUrl m_url;
+        };
+
+        QDir g_directory;
+        QSet<QString> g_missing;
+        bool g_recording{};
+        bool g_replaying{};
+
+        QString fixtureName(const QUrl& url)
+        {
+            return QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1).toHex();
+        }
+
+        QString innerTubeFixtureName(const QString& request)
+        {
+            return "innertube-" + QCryptographicHash::hash(request.toUtf8(), QCryptographicHash::Sha1).toHex();
+        }
+    }
+
+    QString filePath(const QString& name)
+    {
+        return g_directory.filePath(name);
+    }
+
+    QString fixtureKeyPart(const char* arg)
+    {
+        return QString::fromUtf8(arg);
+    }
+
+    QString fixtureKeyPart(const QByteArray& arg)
+    {
+        return QString::fromUtf8(arg);
+    }
+
+    QString fixtureKeyPart(const QJsonObject& arg)
+    {
+        QJsonObject withoutContext = arg;
+        withoutContext.remove("context");
+        return QJsonDocument(withoutContext).toJson(QJsonDocument::Compact);
+    }
+
+    QString fixtureKeyPart(const QString& arg)
+    {
+        return arg;
+    }
+
+    bool isRecording()
+    {
+        return g_recording;
+    }
+
+    bool isReplaying()
+    {
+        return g_replaying;
+    }
+
+    void record(const QUrl& url, HttpReply* reply)
+    {
+        QObject::connect(reply, &HttpReply::finished, [url](const HttpReply& reply) {
+            const QString name = fixtureName(url);
+
+            QFile bodyFile(g_directory.filePath(name + ".body"));
+            QFile metaFile(g_directory.filePath(name + ".json"));
+            if (!bodyFile.open(QFile::WriteOnly | QFile::Truncate) || !metaFile.open(QFile::WriteOnly | QFile::Truncate))
+            {
+                qWarning() << "Failed to record fixture for" << url;
+                return;
+            }
+
+            bodyFile.write(reply.body());
+            metaFile.write(QJsonDocument(QJsonObject {
+                { "statusCode", reply.statusCode() },
+                { "url", url.toString() }
+            }).toJson());
+        });
+    }
+
+    void recordInnerTube(const QString& request, const QJsonValue& response)
+    {
+        QFile file(g_directory.filePath(innerTubeFixtureName(request) + ".json"));
+        if (!file.open(QFile::WriteOnly | QFile::Truncate))
+        {
+            qWarning() << "Failed to record fixture for" << request;
+            return;
+        }
+
+        file.write(QJsonDocument(QJsonObject {
+            { "request", request },
+            { "response", response }
+        }).toJson(QJsonDocument::Compact));
+    }
+
+    HttpReply* replay(const QUrl& url)
+    {
+        const QString name = fixtureName(url);
+
+        QFile bodyFile(g_directory.filePath(name + ".body"));
+        QFile metaFile(g_directory.filePath(name + ".json"));
+        if (!bodyFile.open(QFile::ReadOnly) || !metaFile.open(QFile::ReadOnly))
+        {
+            // only warn once per url, chat benchmarks ask for the same avatars thousands of times
+            if (!g_missing.contains(name))
+            {
+                g_missing.insert(name);
+                qWarning() << "No fixture recorded for" << url;
+            }
+            return new FixtureHttpReply(url, 404, QByteArray());
+        }
+
+        const int statusCode = QJsonDocument::fromJson(metaFile.readAll())["statusCode"].toInt();
+        return new FixtureHttpReply(url, statusCode, bodyFile.readAll());
+    }
+
+    std::optional<QJsonValue> replayInnerTube(const QString& request)
+    {
+        QFile file(g_directory.filePath(innerTubeFixtureName(request) + ".json"));
+        if (!file.open(QFile::ReadOnly))
+        {
+            qWarning() << "No fixture recorded for" << request;
+            return std::nullopt;
+        }
+
+        return QJsonDocument::fromJson(file.readAll())["response"];
+    }
+
+    void startRecording(const QString& directory)
+    {
+        g_directory.setPath(directory);
+        g_directory.mkpath(".");
+        g_recording = true;
+    }
+
+    void startReplaying(const QString& directory)
+    {
+        g_directory.setPath(directory);
+        g_replaying = true;
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "innertube.h"
+#include <QString>
+#include <QTimer>
+
+class HttpReply;
+class QUrl;
+
+// records responses to requests made through HttpUtils::get() and HttpFixtures::getRaw() into a directory (--record)
+// and serves them back from it (--replay), so that traffic can be reproduced without a network.
+namespace HttpFixtures
+{
+    // for recordings of things that aren't HttpUtils traffic, like the chat archiver's raw responses
+    QString filePath(const QString& name);
+    bool isRecording();
+    bool isReplaying();
+    void record(const QUrl& url, HttpReply* reply);
+    void recordInnerTube(const QString& request, const QJsonValue& response);
+    HttpReply* replay(const QUrl& url);
+    std::optional<QJsonValue> replayInnerTube(const QString& request);
+    void startRecording(const QString& directory);
+    void startReplaying(const QString& directory);
+
+    // how an argument to getRaw() shows up in its fixture's key
+    QString fixtureKeyPart(const char* arg);
+    QString fixtureKeyPart(const QByteArray& arg);
+    QString fixtureKeyPart(const QJsonObject& arg); // minus the context, which changes between runs
+    QString fixtureKeyPart(const QString& arg);
+
+    // InnerTube::getRaw(), but recorded and replayed. innertube-qt does its own networking, so its requests
+    // never pass through HttpUtils. the request itself is still built by the endpoint from args, same as get() would,
+    // and responses are keyed by endpoint and those args.
+    template<EndpointWithData E, typename... Args>
+    InnertubeReply<E>* getRaw(const QString& endpoint, const Args&... args)
+    {
+        QString request = "InnerTube " + endpoint;
+        ((request += ' ' + fixtureKeyPart(args)), ...);
+
+        if (isReplaying())
+        {
+            InnertubeReply<E>* reply = new InnertubeReply<E>;
+            // finish on the next event loop iteration like a real reply would, so callers get a chance to connect first
+            QTimer::singleShot(0, reply, [endpoint, reply, response = replayInnerTube(request)] {
+                if (response)
+                    emit reply->finishedRaw(*response);
+                else
+                    emit reply->exception(InnertubeException("No fixture recorded for InnerTube " + endpoint));
+                reply->deleteLater();
+            });
+            return reply;
+        }
+
+        InnertubeReply<E>* reply = InnerTube::instance()->getRaw<E>(args...);
+        if (isRecording())
+        {
+            QObject::connect(reply, &InnertubeReply<E>::finishedRaw, reply, [request](const QJsonValue& data) {
+                recordInnerTube(request, data);
+            });
+        }
+        return reply;
+    }
+}
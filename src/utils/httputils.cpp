@@ -1,9 +1,56 @@
 #include "httputils.h"
 #include "cachedhttp.h"
+#include "httpfixtures.h"
+#include "networkmetrics.h"
 #include "qttubeapplication.h"
+#include "requestscheduler.h"
+#include <QCryptographicHash>
+#include <QHash>
 
 namespace HttpUtils
 {
+    namespace
+    {
+        // replies that haven't finished yet, so identical concurrent requests can share them
+        QHash<QByteArray, HttpReply*> g_inFlight;
+
+        // a dropped reply never finishes, so nobody else can be allowed to join it in the meantime
+        void forgetDropped(HttpReply* reply)
+        {
+            for (auto it = g_inFlight.begin(); it != g_inFlight.end(); ++it)
+            {
+                if (it.value() == reply)
+                {
+                    g_inFlight.erase(it);
+                    return;
+                }
+            }
+        }
+
+        QByteArray requestKey(const QByteArray& method, const QUrl& url, const QByteArray& body = {})
+        {
+            return method + ' ' + url.toEncoded() + ' ' + QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex();
+        }
+
+        HttpReply* send(const QUrl& url, bool cached)
+        {
+            HttpReply* reply;
+            if (HttpFixtures::isReplaying())
+            {
+                reply = HttpFixtures::replay(url);
+            }
+            else
+            {
+                reply = (cached ? cachedInstance() : Http::instance()).get(url);
+                if (HttpFixtures::isRecording())
+                    HttpFixtures::record(url, reply);
+            }
+
+            NetworkMetrics::instance()->track(reply, NetworkMetrics::endpointForUrl(url));
+            return reply;
+        }
+    }
+
     Http& cachedInstance()
     {
         if (qtTubeApp->settings().imageCaching)
@@ -16,4 +63,31 @@ namespace HttpUtils
             return Http::instance();
         }
     }
+
+    HttpReply* get(const QUrl& url, bool cached, RequestPriority priority, QObject* owner)
+    {
+        // the same avatar or emoji is often asked for many times before the first response lands,
+        // which the cache can't help with. hand those callers the reply that's already going.
+        const QByteArray key = requestKey("GET", url);
+        if (HttpReply* inFlight = g_inFlight.value(key))
+        {
+            RequestScheduler::instance()->join(inFlight, priority);
+            NetworkMetrics::instance()->recordCoalesced(NetworkMetrics::endpointForUrl(url));
+            return inFlight;
+        }
+
+        [[maybe_unused]] static const QMetaObject::Connection droppedConnection =
+            QObject::connect(RequestScheduler::instance(), &RequestScheduler::dropped, &forgetDropped);
+
+        HttpReply* reply = RequestScheduler::instance()->schedule(url, priority, owner, std::bind(send, url, cached));
+        g_inFlight.insert(key, reply);
+        auto forget = [key, reply] {
+            if (g_inFlight.value(key) == reply)
+                g_inFlight.remove(key);
+        };
+        QObject::connect(reply, &HttpReply::finished, reply, forget);
+        QObject::connect(reply, &QObject::destroyed, forget);
+
+        return reply;
+    }
 }
@@ -1,7 +1,14 @@
 #pragma once
 #include "http.h"
+#include "requestscheduler.h"
 
 namespace HttpUtils
 {
     Http& cachedInstance();
+    // all app-side GET requests should go through here so they show up in NetworkMetrics.
+    // concurrent requests for the same url share one reply, so callers should only connect to it, not own it.
+    // requests are sent by RequestScheduler in priority order. give an owner (usually the widget the result is for)
+    // if the request should be dropped when that widget goes away before it's sent.
+    HttpReply* get(const QUrl& url, bool cached = false,
+                   RequestPriority priority = RequestPriority::Visible, QObject* owner = nullptr);
 }
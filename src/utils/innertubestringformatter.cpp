@@ -1,9 +1,9 @@
 #include "innertubestringformatter.h"
-#include "utils/httputils.h"
-#include <QLabel>
+#include "emojicache.h"
+#include "ui/widgets/labels/tubelabel.h"
 #include <QUrlQuery>
 
-constexpr QLatin1String EmojiPlaceholder("<img src='data:%1;base64,%2' width='20' height='20'>");
+constexpr QLatin1String EmojiImage("<img src='%1' width='%2' height='%2'>");
 constexpr int MaxUrlLength = 37;
 
 QString InnertubeStringFormatter::formatSimple(const InnertubeObjects::InnertubeString& str, bool useLinkText)
@@ -23,20 +23,10 @@ QString InnertubeStringFormatter::formatSimple(const InnertubeObjects::Innertube
 
 void InnertubeStringFormatter::insertEmoji(const QJsonValue& emoji)
 {
-    ++m_pendingEmojis;
-
     const QString url = emoji["image"]["thumbnails"][0]["url"].toString();
-    const QString placeholder = EmojiPlaceholder.arg(
-        emoji["shortcuts"][0].toString() + emoji["searchTerms"][0].toString() + url);
-
-    if (!m_data.contains(placeholder))
-    {
-        HttpReply* emojiReply = HttpUtils::cachedInstance().get(url);
-        connect(emojiReply, &HttpReply::finished, this,
-                std::bind_front(&InnertubeStringFormatter::replaceEmojiPlaceholder, this, placeholder));
-    }
-
-    m_data += placeholder;
+    m_data += EmojiImage.arg(EmojiCache::instance()->resourceUrl(url)).arg(EmojiCache::Size);
+    if (!EmojiCache::instance()->isLoaded(url) && !m_pendingEmojis.contains(url))
+        m_pendingEmojis.append(url);
 }
 
 void InnertubeStringFormatter::insertNavigationEndpoint(
@@ -117,31 +107,34 @@ void InnertubeStringFormatter::insertNavigationEndpoint(
     data += QStringLiteral("<a href=\"%1\">%2</a>").arg(href, text);
 }
 
-void InnertubeStringFormatter::replaceEmojiPlaceholder(const QString& placeholder, const HttpReply& reply)
-{
-    m_pendingEmojis -= m_data.count(placeholder);
-    m_data.replace(placeholder, EmojiPlaceholder.arg(reply.header("content-type"), reply.body().toBase64()));
-    emit readyRead(m_data);
-
-    if (m_pendingEmojis == 0)
-        emit finished();
-}
-
 void InnertubeStringFormatter::setData(const InnertubeObjects::InnertubeString& str, bool useLinkText)
 {
     for (const InnertubeObjects::InnertubeRun& run : str.runs)
-    {
         if (run.emoji.isObject())
             insertEmoji(run.emoji);
         else if (run.navigationEndpoint.isObject())
             insertNavigationEndpoint(m_data, run.navigationEndpoint, run.text, useLinkText);
         else
             m_data += run.text.toHtmlEscaped().replace('\n', "<br>");
-        emit readyRead(m_data);
-    }
 
-    if (m_pendingEmojis == 0)
-        emit finished();
+    // emojis are referenced rather than embedded, so the text is done as soon as every run is in
+    emit readyRead(m_data);
+    emit finished();
+}
+
+void InnertubeStringFormatter::setLabelText(TubeLabel* label, const InnertubeObjects::InnertubeString& str, bool useLinkText)
+{
+    InnertubeStringFormatter fmt;
+    fmt.setData(str, useLinkText);
+    label->setText(fmt.data());
+
+    if (fmt.pendingEmojis().isEmpty())
+        return;
+
+    EmojiCache::instance()->whenLoaded(fmt.pendingEmojis(), label, [label, text = fmt.data()] {
+        label->setText(QString());
+        label->setText(text);
+    });
 }
 
 void InnertubeStringFormatter::truncateUrlString(QString& url, bool prefix)
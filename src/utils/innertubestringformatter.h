@@ -2,7 +2,7 @@
 #include "innertube/objects/innertubestring.h"
 #include <QObject>
 
-class HttpReply;
+class TubeLabel;
 
 class InnertubeStringFormatter : public QObject
 {
@@ -11,19 +11,22 @@ public:
     explicit InnertubeStringFormatter(QObject* parent = nullptr) : QObject(parent) {}
 
     const QString& data() const { return m_data; }
+    // urls of the custom emojis in the data that are still on their way. see EmojiCache.
+    const QStringList& pendingEmojis() const { return m_pendingEmojis; }
     void setData(const InnertubeObjects::InnertubeString& str, bool useLinkText);
 
     // no support for emojis!!
     static QString formatSimple(const InnertubeObjects::InnertubeString& str, bool useLinkText);
+    // formats str into label. custom emojis that are still on their way have their space saved, and the text
+    // goes in again once the last of them has landed, since label's document keeps what it first got for them.
+    static void setLabelText(TubeLabel* label, const InnertubeObjects::InnertubeString& str, bool useLinkText);
 private:
     QString m_data;
-    uint16_t m_pendingEmojis{};
+    QStringList m_pendingEmojis;
 
     void insertEmoji(const QJsonValue& emoji);
     static void insertNavigationEndpoint(QString& data, const QJsonValue& navigationEndpoint, QString text, bool useLinkText);
     static void truncateUrlString(QString& url, bool prefix);
-private slots:
-    void replaceEmojiPlaceholder(const QString& placeholder, const HttpReply& reply);
 signals:
     void finished();
     void readyRead(const QString& data);
@@ -0,0 +1,141 @@
+#include "metadatacache.h"
+#include "httputils.h"
+#include "networkmetrics.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStandardPaths>
+
+namespace
+{
+    struct SourceInfo
+    {
+        QLatin1String name;
+        QLatin1String urlTemplate;
+        int ttl; // seconds
+        bool persisted;
+    };
+
+    // RYD only updates its counts every so often, so they're fine to keep around (even across restarts).
+    // socialcounts is meant to be live, so it's only kept long enough to cover a burst of labels for the same channel.
+    const SourceInfo& sourceInfo(MetadataCache::Source source)
+    {
+        static const SourceInfo ReturnYouTubeDislike {
+            QLatin1String("ryd"), QLatin1String("https://returnyoutubedislikeapi.com/votes?videoId=%1"), 600, true
+        };
+        static const SourceInfo SocialCounts {
+            QLatin1String("socialcounts"), QLatin1String("https://api.socialcounts.org/youtube-live-subscriber-count/%1"), 120, false
+        };
+
+        switch (source)
+        {
+        case MetadataCache::Source::ReturnYouTubeDislike: return ReturnYouTubeDislike;
+        case MetadataCache::Source::SocialCounts: return SocialCounts;
+        }
+
+        Q_UNREACHABLE();
+    }
+}
+
+MetadataCache* MetadataCache::instance()
+{
+    std::call_once(m_onceFlag, [] { m_instance = new MetadataCache; });
+    return m_instance;
+}
+
+MetadataCache::MetadataCache(QObject* parent)
+    : QObject(parent),
+      m_path(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + "metadata.json")
+{
+    load();
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &MetadataCache::save);
+}
+
+void MetadataCache::get(Source source, const QString& key, QObject* context,
+                        const std::function<void(const QByteArray&)>& callback)
+{
+    const SourceInfo& info = sourceInfo(source);
+    const QString cacheKey = QString(info.name) + '/' + key;
+    const QUrl url(QString(info.urlTemplate).arg(key));
+    const QString endpoint = NetworkMetrics::endpointForUrl(url);
+
+    if (!context)
+        context = this;
+
+    if (auto it = m_entries.constFind(cacheKey); it != m_entries.cend())
+    {
+        if (it->expires > QDateTime::currentDateTimeUtc())
+        {
+            NetworkMetrics::instance()->recordCacheHit(endpoint);
+            QMetaObject::invokeMethod(context, [callback, body = it->body] { callback(body); }, Qt::QueuedConnection);
+            return;
+        }
+
+        m_entries.erase(it);
+    }
+
+    if (auto it = m_waiting.find(cacheKey); it != m_waiting.end())
+    {
+        NetworkMetrics::instance()->recordCoalesced(endpoint);
+        it->append(Waiter { callback, context });
+        return;
+    }
+
+    m_waiting.insert(cacheKey, { Waiter { callback, context } });
+
+    HttpReply* reply = HttpUtils::get(url, false, RequestPriority::UserInitiated);
+    connect(reply, &HttpReply::finished, this, [this, cacheKey, info](const HttpReply& reply) {
+        const QByteArray body = reply.isSuccessful() ? reply.body() : QByteArray();
+        if (!body.isEmpty())
+            m_entries.insert(cacheKey, Entry { body, QDateTime::currentDateTimeUtc().addSecs(info.ttl), info.persisted });
+
+        const QList<Waiter> waiters = m_waiting.take(cacheKey);
+        for (const Waiter& waiter : waiters)
+            if (waiter.context)
+                QMetaObject::invokeMethod(waiter.context.data(), [callback = waiter.callback, body] { callback(body); }, Qt::QueuedConnection);
+    });
+}
+
+void MetadataCache::load()
+{
+    QFile file(m_path);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    const QJsonObject entries = QJsonDocument::fromJson(file.readAll()).object();
+    for (auto it = entries.begin(); it != entries.end(); ++it)
+    {
+        const QDateTime expires = QDateTime::fromMSecsSinceEpoch(it.value()["expires"].toVariant().toLongLong(), Qt::UTC);
+        if (expires > now)
+            m_entries.insert(it.key(), Entry { it.value()["body"].toString().toUtf8(), expires, true });
+    }
+}
+
+void MetadataCache::save() const
+{
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+
+    QJsonObject entries;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it)
+    {
+        if (it->persisted && it->expires > now)
+        {
+            entries.insert(it.key(), QJsonObject {
+                { "body", QString::fromUtf8(it->body) },
+                { "expires", it->expires.toMSecsSinceEpoch() }
+            });
+        }
+    }
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+
+    QFile file(m_path);
+    if (file.open(QFile::WriteOnly | QFile::Truncate))
+        file.write(QJsonDocument(entries).toJson(QJsonDocument::Compact));
+    else
+        qWarning() << "Failed to save metadata cache:" << file.errorString();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <QDateTime>
+#include <QHash>
+#include <QPointer>
+
+// caches responses from third-party metadata APIs (Return YouTube Dislike, socialcounts) for a while,
+// so that channel labels and watch view refreshes asking for the same thing don't each cost a request.
+// how long an entry lives and whether it survives a restart depends on the source.
+// hits show up as cache hits and joined lookups as coalesced in NetworkMetrics.
+class MetadataCache : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Source { ReturnYouTubeDislike, SocialCounts };
+
+    static MetadataCache* instance();
+    explicit MetadataCache(QObject* parent = nullptr);
+
+    // calls back with the response body for key, or an empty body if the request failed (failures aren't cached).
+    // the callback is always queued, and is dropped if context is destroyed first.
+    void get(Source source, const QString& key, QObject* context, const std::function<void(const QByteArray&)>& callback);
+private:
+    struct Entry
+    {
+        QByteArray body;
+        QDateTime expires;
+        bool persisted{};
+    };
+
+    struct Waiter
+    {
+        std::function<void(const QByteArray&)> callback;
+        QPointer<QObject> context;
+    };
+
+    static inline MetadataCache* m_instance;
+    static inline std::once_flag m_onceFlag;
+
+    QHash<QString, Entry> m_entries;
+    QString m_path;
+    QHash<QString, QList<Waiter>> m_waiting;
+
+    void load();
+    void save() const;
+};
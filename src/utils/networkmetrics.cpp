@@ -0,0 +1,155 @@
+#include "networkmetrics.h"
+#include "http.h"
+#include <QJsonArray>
+#include <QtMath>
+
+NetworkMetrics* NetworkMetrics::instance()
+{
+    std::call_once(m_onceFlag, [] { m_instance = new NetworkMetrics; });
+    return m_instance;
+}
+
+QString NetworkMetrics::endpointForUrl(const QUrl& url)
+{
+    // group by host and the first path segment (or two for "api/..." paths), which separates
+    // things like ytimg's /vi/ and socialcounts' endpoints without making a key per video or image.
+    // long segments are almost always ids or tokens, so they're left off.
+    const QStringList segments = url.path().split('/', Qt::SkipEmptyParts);
+    const qsizetype depth = !segments.isEmpty() && segments.first() == "api" ? 2 : 1;
+
+    QString endpoint = url.host();
+    for (qsizetype i = 0; i < std::min(depth, segments.size()); ++i)
+    {
+        if (segments[i].size() > 32)
+            break;
+        endpoint += '/' + segments[i];
+    }
+
+    return endpoint;
+}
+
+qint64 NetworkMetrics::EndpointStats::latencyPercentile(double percentile) const
+{
+    if (requests == 0)
+        return 0;
+
+    // approximated as the upper bound of the bucket the percentile falls in
+    const int target = std::max(1, qCeil(requests * percentile));
+    int seen = 0;
+    for (size_t i = 0; i < LatencyBucketBounds.size(); ++i)
+    {
+        seen += latencyBuckets[i];
+        if (seen >= target)
+            return std::min(LatencyBucketBounds[i], maxLatency);
+    }
+
+    return maxLatency;
+}
+
+void NetworkMetrics::record(const QString& endpoint, qint64 latency, qint64 bytes, bool cacheHit, bool error)
+{
+    EndpointStats& stats = m_endpoints[endpoint];
+    stats.bytes += bytes;
+    stats.cacheHits += cacheHit;
+    stats.errors += error;
+    stats.maxLatency = std::max(stats.maxLatency, latency);
+    stats.requests++;
+    stats.totalLatency += latency;
+
+    auto bucket = std::ranges::lower_bound(LatencyBucketBounds, latency);
+    stats.latencyBuckets[std::distance(LatencyBucketBounds.begin(), bucket)]++;
+
+    emit updated();
+}
+
+void NetworkMetrics::recordCacheHit(const QString& endpoint)
+{
+    m_endpoints[endpoint].memoryCacheHits++;
+    emit updated();
+}
+
+void NetworkMetrics::recordCoalesced(const QString& endpoint)
+{
+    m_endpoints[endpoint].coalesced++;
+    emit updated();
+}
+
+void NetworkMetrics::recordItems(const QString& endpoint, int count, qint64 totalLatency)
+{
+    EndpointStats& stats = m_endpoints[endpoint];
+    stats.items += count;
+    stats.totalItemLatency += totalLatency;
+    emit updated();
+}
+
+void NetworkMetrics::recordSkipped(const QString& endpoint)
+{
+    m_endpoints[endpoint].skipped++;
+    emit updated();
+}
+
+double NetworkMetrics::requestsPerHour(const EndpointStats& stats) const
+{
+    const qint64 elapsed = m_sinceReset.elapsed();
+    return elapsed > 0 ? stats.requests * 3600000.0 / elapsed : 0;
+}
+
+void NetworkMetrics::reset()
+{
+    m_endpoints.clear();
+    m_sinceReset.restart();
+    emit updated();
+}
+
+QJsonObject NetworkMetrics::toJson() const
+{
+    QJsonObject out;
+    for (auto it = m_endpoints.cbegin(); it != m_endpoints.cend(); ++it)
+    {
+        const EndpointStats& stats = it.value();
+
+        QJsonArray histogram;
+        for (size_t i = 0; i < stats.latencyBuckets.size(); ++i)
+        {
+            histogram.append(QJsonObject {
+                { "count", stats.latencyBuckets[i] },
+                { "upperBoundMs", i < LatencyBucketBounds.size() ? QJsonValue(LatencyBucketBounds[i]) : QJsonValue() }
+            });
+        }
+
+        out.insert(it.key(), QJsonObject {
+            { "bytes", stats.bytes },
+            { "bytesSavedEstimate", stats.bytesSaved() },
+            { "cacheHitRatio", stats.cacheHitRatio() },
+            { "cacheHits", stats.cacheHits },
+            { "coalesced", stats.coalesced },
+            { "errorRate", stats.errorRate() },
+            { "errors", stats.errors },
+            { "items", stats.items },
+            { "latencyHistogram", histogram },
+            { "maxLatencyMs", stats.maxLatency },
+            { "meanItemLatencyMs", stats.meanItemLatency() },
+            { "meanLatencyMs", stats.meanLatency() },
+            { "memoryCacheHits", stats.memoryCacheHits },
+            { "p50LatencyMs", stats.latencyPercentile(0.5) },
+            { "p95LatencyMs", stats.latencyPercentile(0.95) },
+            { "requests", stats.requests },
+            { "requestsPerHour", requestsPerHour(stats) },
+            { "skipped", stats.skipped }
+        });
+    }
+
+    return out;
+}
+
+void NetworkMetrics::track(HttpReply* reply, const QString& endpoint)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // CachedHttp answers cache hits with its own reply type without touching the network
+    const bool cacheHit = reply->inherits("CachedHttpReply");
+    connect(reply, &HttpReply::finished, this, [this, cacheHit, endpoint, timer](const HttpReply& reply) {
+        record(endpoint, timer.elapsed(), reply.body().size(), cacheHit, !reply.isSuccessful());
+    });
+}
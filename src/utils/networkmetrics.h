@@ -0,0 +1,126 @@
+#pragma once
+#include "innertube.h"
+#include <array>
+#include <mutex>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMap>
+
+class HttpReply;
+
+// per-endpoint request statistics. everything that goes through HttpUtils::get() is recorded,
+// InnerTube replies can be recorded with track(), and blocking InnerTube requests by making them through getBlocking().
+// InnerTube response sizes are only known for raw replies, since parsed ones don't keep their JSON around.
+class NetworkMetrics : public QObject
+{
+    Q_OBJECT
+public:
+    // upper bounds (in ms) of the latency histogram buckets. anything slower lands in an extra overflow bucket.
+    static constexpr std::array<qint64, 7> LatencyBucketBounds = { 50, 100, 250, 500, 1000, 2500, 5000 };
+
+    struct EndpointStats
+    {
+        qint64 bytes{};
+        int cacheHits{};
+        int coalesced{}; // requests that joined one already in flight instead of making their own
+        int errors{};
+        int items{}; // things delivered by polled endpoints, like live chat messages
+        std::array<int, LatencyBucketBounds.size() + 1> latencyBuckets{};
+        qint64 maxLatency{};
+        int memoryCacheHits{}; // answered from memory without making a request at all, so they don't count as one
+        int requests{};
+        int skipped{}; // requests that were dropped before being sent, like images that were never scrolled to
+        qint64 totalItemLatency{}; // how old those items already were by the time they arrived
+        qint64 totalLatency{};
+
+        // a guess, since skipped requests never got a response to measure
+        qint64 bytesSaved() const { return requests > 0 ? skipped * (bytes / requests) : 0; }
+
+        double cacheHitRatio() const
+        {
+            const int lookups = requests + memoryCacheHits;
+            return lookups > 0 ? double(cacheHits + memoryCacheHits) / lookups : 0;
+        }
+        double errorRate() const { return requests > 0 ? double(errors) / requests : 0; }
+        qint64 latencyPercentile(double percentile) const;
+        qint64 meanItemLatency() const { return items > 0 ? totalItemLatency / items : 0; }
+        qint64 meanLatency() const { return requests > 0 ? totalLatency / requests : 0; }
+    };
+
+    static NetworkMetrics* instance();
+    explicit NetworkMetrics(QObject* parent = nullptr) : QObject(parent) { m_sinceReset.start(); }
+
+    const QMap<QString, EndpointStats>& endpoints() const { return m_endpoints; }
+
+    // InnerTube::getBlocking(), but timed and recorded. safe to call off the main thread.
+    template<EndpointWithData E, typename... Args>
+    E getBlocking(const QString& endpoint, Args&&... args)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        auto recordQueued = [this, endpoint, timer](bool error) {
+            QMetaObject::invokeMethod(this, [this, endpoint, error, latency = timer.elapsed()] {
+                record("InnerTube " + endpoint, latency, 0, false, error);
+            });
+        };
+
+        try
+        {
+            E result = InnerTube::instance()->getBlocking<E>(std::forward<Args>(args)...);
+            recordQueued(false);
+            return result;
+        }
+        catch (const InnertubeException&)
+        {
+            recordQueued(true);
+            throw;
+        }
+    }
+
+    void record(const QString& endpoint, qint64 latency, qint64 bytes, bool cacheHit, bool error);
+    void recordCacheHit(const QString& endpoint);
+    void recordCoalesced(const QString& endpoint);
+    void recordItems(const QString& endpoint, int count, qint64 totalLatency);
+    void recordSkipped(const QString& endpoint);
+    // over the time since startup or the last reset, for comparing polling strategies
+    double requestsPerHour(const EndpointStats& stats) const;
+    void reset();
+    QJsonObject toJson() const;
+    void track(HttpReply* reply, const QString& endpoint);
+
+    template<typename E>
+    void track(InnertubeReply<E>* reply, const QString& endpoint)
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        // raw replies emit finishedRaw instead of finished, so listen for both and only count once
+        std::shared_ptr<bool> recorded = std::make_shared<bool>(false);
+        auto recordOnce = [this, endpoint, recorded, timer](bool error, qint64 bytes) {
+            if (*recorded)
+                return;
+            *recorded = true;
+            record("InnerTube " + endpoint, timer.elapsed(), bytes, false, error);
+        };
+
+        connect(reply, &InnertubeReply<E>::exception, this, [recordOnce] { recordOnce(true, 0); });
+        connect(reply, &InnertubeReply<E>::finished, this, [recordOnce] { recordOnce(false, 0); });
+        connect(reply, &InnertubeReply<E>::finishedRaw, this, [recordOnce](const QJsonValue& data) {
+            // the size of the compacted JSON rather than what came over the wire, but close enough to compare with
+            const QJsonDocument doc = data.isArray() ? QJsonDocument(data.toArray()) : QJsonDocument(data.toObject());
+            recordOnce(false, doc.toJson(QJsonDocument::Compact).size());
+        });
+    }
+
+    static QString endpointForUrl(const QUrl& url);
+private:
+    static inline NetworkMetrics* m_instance;
+    static inline std::once_flag m_onceFlag;
+
+    QMap<QString, EndpointStats> m_endpoints;
+    QElapsedTimer m_sinceReset;
+signals:
+    void updated();
+};
@@ -20,9 +20,14 @@
 #include <IOKit/pwr_mgt/IOPMLib.h>
 #endif
 
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
 #ifdef Q_OS_WIN
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
+#include <psapi.h>
 #endif
 
 namespace OSUtils
@@ -59,6 +64,27 @@ namespace OSUtils
         return QString();
     }
 
+    qint64 peakMemoryUsage()
+    {
+    #if defined(Q_OS_WIN)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+        return -1;
+    #elif defined(Q_OS_UNIX)
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return -1;
+    # ifdef Q_OS_MACOS
+        return usage.ru_maxrss; // already in bytes here
+    # else
+        return usage.ru_maxrss * 1024;
+    # endif
+    #else
+        return -1;
+    #endif
+    }
+
 #ifdef Q_OS_MACOS
     void suspendIdleSleepMacOS(bool suspend, const char* status)
     {
@@ -6,5 +6,7 @@ class QFileInfo;
 namespace OSUtils
 {
     QString getFullPath(const QFileInfo& fileInfo);
+    // peak resident set size of this process in bytes, or -1 if unsupported
+    qint64 peakMemoryUsage();
     void suspendIdleSleep(bool suspend);
 }
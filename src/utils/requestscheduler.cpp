@@ -0,0 +1,276 @@
+#include "requestscheduler.h"
+#include "http.h"
+#include "networkmetrics.h"
+#include <QTimer>
+
+// what callers get back from schedule(). it stands in for the real reply until the scheduler
+// sends the request, then passes the real reply's result on when it finishes.
+class ScheduledHttpReply : public HttpReply
+{
+public:
+    explicit ScheduledHttpReply(const QUrl& url) : m_url(url) {}
+
+    void attach(HttpReply* reply)
+    {
+        m_reply = reply;
+        connect(reply, &HttpReply::finished, this, &ScheduledHttpReply::finish);
+        // otherwise callers (and anyone who joined this reply) would wait on it forever.
+        // it's already gone, so this finishes with nothing: no body and a status code of 0.
+        connect(reply, &QObject::destroyed, this, &ScheduledHttpReply::finish);
+    }
+
+    QByteArray body() const override { return m_reply ? m_reply->body() : QByteArray(); }
+    QByteArray header(const QByteArray& headerName) const override
+    { return m_reply ? m_reply->header(headerName) : QByteArray(); }
+    int statusCode() const override { return m_reply ? m_reply->statusCode() : 0; }
+    QUrl url() const override { return m_url; }
+private:
+    bool m_finished{};
+    QPointer<HttpReply> m_reply;
+    QUrl m_url;
+
+    void finish()
+    {
+        if (std::exchange(m_finished, true))
+            return;
+        emit finished(*this);
+        deleteLater();
+    }
+};
+
+RequestScheduler* RequestScheduler::instance()
+{
+    std::call_once(m_onceFlag, [] { m_instance = new RequestScheduler; });
+    return m_instance;
+}
+
+void RequestScheduler::cancel(QObject* owner)
+{
+    drop([owner](const Pending& pending) { return pending.owned && isOwnedBy(pending.owner, owner); });
+
+    const QList<QObject*> heldOwners = m_heldBack.keys();
+    for (QObject* heldOwner : heldOwners)
+        if (isOwnedBy(heldOwner, owner))
+            dropHeldBack(heldOwner);
+}
+
+void RequestScheduler::deferWithin(QObject* container)
+{
+    m_deferringContainers.append(container);
+}
+
+void RequestScheduler::discard(const Pending& pending)
+{
+    // never sent, so that's traffic saved
+    NetworkMetrics::instance()->recordSkipped(NetworkMetrics::endpointForUrl(pending.url));
+    if (pending.reply)
+    {
+        emit dropped(pending.reply);
+        pending.reply->deleteLater();
+    }
+}
+
+void RequestScheduler::drop(const std::function<bool(const Pending&)>& predicate)
+{
+    // partition rather than remove_if, the dropped replies still need to be deleted
+    auto dropped = std::stable_partition(m_pending.begin(), m_pending.end(), std::not_fn(predicate));
+    std::for_each(dropped, m_pending.end(), std::bind_front(&RequestScheduler::discard, this));
+    m_pending.erase(dropped, m_pending.end());
+}
+
+void RequestScheduler::dropHeldBack(QObject* owner)
+{
+    disconnect(owner, &QObject::destroyed, this, nullptr);
+    const QList<Pending> heldBack = m_heldBack.take(owner);
+    for (const Pending& pending : heldBack)
+        discard(pending);
+}
+
+void RequestScheduler::finished(const QString& host)
+{
+    --m_active;
+    if (--m_activePerHost[host] == 0)
+        m_activePerHost.remove(host);
+    queuePump();
+}
+
+void RequestScheduler::hold(Pending&& pending)
+{
+    QObject* owner = pending.owner;
+    auto it = m_heldBack.find(owner);
+    if (it == m_heldBack.end())
+    {
+        it = m_heldBack.insert(owner, {});
+        connect(owner, &QObject::destroyed, this, [this, owner] { dropHeldBack(owner); });
+    }
+
+    it->append(std::move(pending));
+}
+
+bool RequestScheduler::isHeldBack(const Pending& pending)
+{
+    if (pending.priority == RequestPriority::Deferred)
+        return true;
+    if (!pending.owned || pending.ranked)
+        return false;
+
+    return std::ranges::any_of(m_deferringContainers, [&pending](const QPointer<QObject>& container) {
+        return container && isOwnedBy(pending.owner, container);
+    });
+}
+
+bool RequestScheduler::isOwnedBy(QObject* object, QObject* owner)
+{
+    for (; object; object = object->parent())
+        if (object == owner)
+            return true;
+    return false;
+}
+
+void RequestScheduler::join(HttpReply* reply, RequestPriority priority)
+{
+    auto isReply = [reply](const Pending& pending) { return pending.reply == reply; };
+    auto it = std::ranges::find_if(m_pending, isReply);
+    if (it == m_pending.end())
+    {
+        // a held back reply comes back out, since it's no longer only up to its owner when it goes
+        QObject* heldOwner{};
+        for (auto held = m_heldBack.cbegin(); held != m_heldBack.cend() && !heldOwner; ++held)
+            if (std::ranges::any_of(held.value(), isReply))
+                heldOwner = held.key();
+        if (!heldOwner)
+            return;
+
+        release(heldOwner);
+        it = std::ranges::find_if(m_pending, isReply);
+    }
+
+    it->owned = false;
+    it->priority = std::min(it->priority, priority);
+    queuePump();
+}
+
+void RequestScheduler::pump()
+{
+    m_pumpQueued = false;
+
+    // requests whose owner is gone would only be thrown away, so drop them before they use up a slot
+    drop([](const Pending& pending) { return !pending.reply || (pending.owned && !pending.owner); });
+    m_deferringContainers.removeAll(nullptr);
+
+    // requests that are held back are set aside until setPriority() raises them
+    auto heldBack = std::stable_partition(m_pending.begin(), m_pending.end(),
+                                          [this](const Pending& pending) { return !pending.owned || !isHeldBack(pending); });
+    for (auto it = heldBack; it != m_pending.end(); ++it)
+        hold(std::move(*it));
+    m_pending.erase(heldBack, m_pending.end());
+
+    // m_pending is in arrival order, so a stable sort keeps each priority first come, first served
+    std::stable_sort(m_pending.begin(), m_pending.end(),
+                     [](const Pending& a, const Pending& b) { return a.priority < b.priority; });
+
+    for (auto it = m_pending.begin(); it != m_pending.end();)
+    {
+        // user-initiated requests only have to wait on their host, never on image traffic as a whole
+        if (m_active >= MaxActive && it->priority != RequestPriority::UserInitiated)
+            break;
+
+        const QString host = it->url.host();
+        // ownerless requests are the only ones that can still be held back here
+        if (m_activePerHost.value(host) >= MaxActivePerHost || isHeldBack(*it))
+        {
+            ++it;
+            continue;
+        }
+
+        HttpReply* reply = it->send();
+        it->reply->attach(reply);
+
+        ++m_active;
+        ++m_activePerHost[host];
+
+        // a reply that's destroyed without finishing has to give its slot back too
+        std::shared_ptr<bool> released = std::make_shared<bool>(false);
+        auto release = [this, host, released] {
+            if (std::exchange(*released, true))
+                return;
+            finished(host);
+        };
+        connect(reply, &HttpReply::finished, this, release);
+        connect(reply, &QObject::destroyed, this, release);
+
+        it = m_pending.erase(it);
+    }
+}
+
+void RequestScheduler::queuePump()
+{
+    // coalesce pumps, lists schedule dozens of requests in a row and only the last pump would matter
+    if (m_pumpQueued)
+        return;
+
+    m_pumpQueued = true;
+    QTimer::singleShot(0, this, &RequestScheduler::pump);
+}
+
+void RequestScheduler::release(QObject* owner)
+{
+    disconnect(owner, &QObject::destroyed, this, nullptr);
+    m_pending.append(m_heldBack.take(owner));
+    queuePump();
+}
+
+HttpReply* RequestScheduler::schedule(const QUrl& url, RequestPriority priority, QObject* owner,
+                                      const std::function<HttpReply*()>& send)
+{
+    ScheduledHttpReply* reply = new ScheduledHttpReply(url);
+    m_pending.append(Pending {
+        .owner = owner,
+        .owned = owner != nullptr,
+        .priority = priority,
+        .reply = reply,
+        .send = send,
+        .url = url
+    });
+
+    queuePump();
+    return reply;
+}
+
+void RequestScheduler::setPriority(QObject* owner, RequestPriority priority)
+{
+    auto rank = [priority](Pending& pending) {
+        const bool changed = pending.priority != priority || !pending.ranked;
+        pending.priority = priority;
+        pending.ranked = true;
+        return changed;
+    };
+
+    bool changed{};
+    for (Pending& pending : m_pending)
+        if (pending.owned && isOwnedBy(pending.owner, owner))
+            changed |= rank(pending);
+
+    if (!m_heldBack.isEmpty())
+    {
+        // looked up by owner rather than walking every held back request, there are far fewer children than those
+        QList<QObject*> owners = owner->findChildren<QObject*>();
+        owners.prepend(owner);
+        for (QObject* heldOwner : std::as_const(owners))
+        {
+            auto it = m_heldBack.find(heldOwner);
+            if (it == m_heldBack.end())
+                continue;
+
+            for (Pending& pending : *it)
+                rank(pending);
+
+            // ranked with anything but deferred means they're no longer held back
+            if (priority != RequestPriority::Deferred)
+                release(heldOwner);
+        }
+    }
+
+    if (changed)
+        queuePump();
+}
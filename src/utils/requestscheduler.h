@@ -0,0 +1,75 @@
+#pragma once
+#include <functional>
+#include <mutex>
+#include <QHash>
+#include <QPointer>
+#include <QUrl>
+
+class HttpReply;
+class ScheduledHttpReply;
+
+// deferred requests aren't sent at all until something raises them
+enum class RequestPriority { UserInitiated, Visible, Prefetch, Background, Deferred };
+
+// decides when HttpUtils::get() requests actually go out: higher priorities first, with a limited number
+// on the network at once (per host and overall). requests with an owner can be reprioritized or dropped
+// while they're still waiting, which is how lists keep offscreen thumbnails from getting in the way.
+class RequestScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int MaxActive = 16;
+    static constexpr int MaxActivePerHost = 6;
+
+    static RequestScheduler* instance();
+    explicit RequestScheduler(QObject* parent = nullptr) : QObject(parent) {}
+
+    // drops waiting requests owned by owner or any of its children. requests already on the network are left alone.
+    void cancel(QObject* owner);
+    // holds back requests owned by anything inside container until they've been given a priority with setPriority().
+    // for views that only want to load what's near the visible area.
+    void deferWithin(QObject* container);
+    // for a second caller sharing a reply: raises it to priority if that's higher and makes it
+    // ownerless, since it's no longer only the first owner's to cancel.
+    void join(HttpReply* reply, RequestPriority priority);
+    HttpReply* schedule(const QUrl& url, RequestPriority priority, QObject* owner, const std::function<HttpReply*()>& send);
+    // changes the priority of waiting requests owned by owner or any of its children.
+    void setPriority(QObject* owner, RequestPriority priority);
+private:
+    struct Pending
+    {
+        QPointer<QObject> owner;
+        bool owned{};
+        RequestPriority priority;
+        bool ranked{};
+        QPointer<ScheduledHttpReply> reply;
+        std::function<HttpReply*()> send;
+        QUrl url;
+    };
+
+    static inline RequestScheduler* m_instance;
+    static inline std::once_flag m_onceFlag;
+
+    int m_active{};
+    QHash<QString, int> m_activePerHost;
+    QList<QPointer<QObject>> m_deferringContainers;
+    // held back requests, by owner. they're kept out of m_pending so pumps don't walk past every offscreen
+    // item in a list each time, and are dropped as soon as their owner goes away.
+    QHash<QObject*, QList<Pending>> m_heldBack;
+    QList<Pending> m_pending;
+    bool m_pumpQueued{};
+
+    static bool isOwnedBy(QObject* object, QObject* owner);
+    void discard(const Pending& pending);
+    void drop(const std::function<bool(const Pending&)>& predicate);
+    void dropHeldBack(QObject* owner);
+    void finished(const QString& host);
+    void hold(Pending&& pending);
+    bool isHeldBack(const Pending& pending);
+    void pump();
+    void queuePump();
+    void release(QObject* owner);
+signals:
+    // a waiting request was dropped without being sent. its reply will never finish, and is about to be deleted.
+    void dropped(HttpReply* reply);
+};
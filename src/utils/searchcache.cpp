@@ -0,0 +1,43 @@
+#include "searchcache.h"
+#include "networkmetrics.h"
+
+SearchCache* SearchCache::instance()
+{
+    std::call_once(m_onceFlag, [] { m_instance = new SearchCache; });
+    return m_instance;
+}
+
+void SearchCache::insert(const QByteArray& key, const QJsonValue& response)
+{
+    if (auto it = std::ranges::find(m_entries, key, &Entry::key); it != m_entries.end())
+        m_entries.erase(it);
+
+    m_entries.prepend(Entry { key, response, QDateTime::currentDateTimeUtc() });
+    if (m_entries.size() > MaxEntries)
+        m_entries.removeLast();
+}
+
+QByteArray SearchCache::key(const QString& query, const QByteArray& params, const QString& continuationToken)
+{
+    return query.toUtf8() + '\n' + params + '\n' + continuationToken.toUtf8();
+}
+
+QJsonValue SearchCache::value(const QByteArray& key)
+{
+    auto it = std::ranges::find(m_entries, key, &Entry::key);
+    if (it == m_entries.end())
+        return QJsonValue(QJsonValue::Undefined);
+
+    if (it->stored.secsTo(QDateTime::currentDateTimeUtc()) > MaxAge)
+    {
+        m_entries.erase(it);
+        return QJsonValue(QJsonValue::Undefined);
+    }
+
+    const Entry entry = *it;
+    m_entries.erase(it);
+    m_entries.prepend(entry);
+
+    NetworkMetrics::instance()->recordCacheHit("InnerTube Search");
+    return entry.response;
+}
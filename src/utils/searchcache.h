@@ -0,0 +1,36 @@
+#pragma once
+#include <mutex>
+#include <QDateTime>
+#include <QJsonValue>
+#include <QList>
+
+// recent raw search responses, so re-running a query (or flipping a filter back) doesn't go over the network again.
+// first pages are keyed by query and compiled filter params, continuations by the token that asked for them,
+// so a continuation is only ever served after the page that handed out its token.
+// hits show up as cache hits in NetworkMetrics.
+class SearchCache
+{
+public:
+    static constexpr int MaxAge = 600; // seconds
+    static constexpr int MaxEntries = 48;
+
+    static SearchCache* instance();
+
+    static QByteArray key(const QString& query, const QByteArray& params, const QString& continuationToken);
+
+    void insert(const QByteArray& key, const QJsonValue& response);
+    // undefined if there's nothing fresh for key
+    QJsonValue value(const QByteArray& key);
+private:
+    struct Entry
+    {
+        QByteArray key;
+        QJsonValue response;
+        QDateTime stored;
+    };
+
+    static inline SearchCache* m_instance;
+    static inline std::once_flag m_onceFlag;
+
+    QList<Entry> m_entries; // most recently used first
+};
@@ -0,0 +1,213 @@
+#include "searchsuggestions.h"
+#include "httputils.h"
+#include "qttubeapplication.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUrlQuery>
+
+// the server never gives more than this, so a prefix that got fewer back has nothing else to offer
+constexpr int ServerLimit = 10;
+
+SearchSuggestions* SearchSuggestions::instance()
+{
+    std::call_once(m_onceFlag, [] { m_instance = new SearchSuggestions; });
+    return m_instance;
+}
+
+SearchSuggestions::SearchSuggestions(QObject* parent)
+    : QObject(parent),
+      m_debounceTimer(new QTimer(this)),
+      m_historyPath(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + QDir::separator() + "searchhistory.json"),
+      m_serverUrl("https://suggestqueries-clients6.youtube.com/complete/search?client=firefox&ds=yt")
+{
+    m_debounceTimer->setInterval(DebounceInterval);
+    m_debounceTimer->setSingleShot(true);
+    connect(m_debounceTimer, &QTimer::timeout, this, &SearchSuggestions::fetch);
+
+    loadHistory();
+}
+
+void SearchSuggestions::addToHistory(const QString& text)
+{
+    const QString entry = text.simplified();
+    if (entry.isEmpty() || !qtTubeApp->settings().searchHistory)
+        return;
+
+    m_history.erase(std::remove_if(m_history.begin(), m_history.end(),
+                                   [key = normalized(entry)](const QString& existing) { return normalized(existing) == key; }),
+                    m_history.end());
+    m_history.prepend(entry);
+    if (m_history.size() > MaxHistory)
+        m_history.removeLast();
+
+    // it's small, and written right away it can't be lost to a crash
+    saveHistory();
+}
+
+void SearchSuggestions::cancel()
+{
+    ++m_generation;
+    m_debounceTimer->stop();
+    RequestScheduler::instance()->cancel(this);
+}
+
+void SearchSuggestions::clearHistory()
+{
+    m_history.clear();
+    if (QFile::exists(m_historyPath) && !QFile::remove(m_historyPath))
+        qWarning() << "Failed to remove search history:" << m_historyPath;
+}
+
+void SearchSuggestions::fetch()
+{
+    const quint64 generation = m_generation;
+    const QString text = m_pending;
+
+    QUrl url(m_serverUrl);
+    QUrlQuery query(url);
+    query.addQueryItem("q", text);
+    url.setQuery(query);
+
+    HttpReply* reply = HttpUtils::get(url, false, RequestPriority::UserInitiated, this);
+    connect(reply, &HttpReply::finished, this, [this, generation, text](const HttpReply& reply) {
+        if (!reply.isSuccessful())
+            return;
+
+        // [query, [suggestion, ...], ...]
+        QStringList results;
+        const QJsonArray suggestions = QJsonDocument::fromJson(reply.body()).array().at(1).toArray();
+        for (const QJsonValue& suggestion : suggestions)
+            if (const QString str = suggestion.toString(); !str.isEmpty())
+                results.append(str);
+
+        // worth keeping even if the user has typed on since, narrowing can still use it
+        insertCache(normalized(text), results);
+        if (generation == m_generation)
+            emit ready(text, merge(normalized(text), results));
+    });
+}
+
+void SearchSuggestions::insertCache(const QString& prefix, const QStringList& results)
+{
+    if (auto it = std::ranges::find(m_cache, prefix, &CacheEntry::prefix); it != m_cache.end())
+        m_cache.erase(it);
+    m_cache.prepend(CacheEntry { prefix, results });
+    if (m_cache.size() > MaxCachedPrefixes)
+        m_cache.removeLast();
+}
+
+void SearchSuggestions::loadHistory()
+{
+    QFile file(m_historyPath);
+    if (!file.open(QFile::ReadOnly))
+        return;
+
+    const QJsonArray history = QJsonDocument::fromJson(file.readAll()).array();
+    for (const QJsonValue& entry : history)
+        if (m_history.size() < MaxHistory)
+            m_history.append(entry.toString());
+}
+
+// a candidate matches if any of its words starts with the key
+bool SearchSuggestions::matches(const QString& candidate, const QString& key)
+{
+    const QString normalizedCandidate = normalized(candidate);
+    return normalizedCandidate.startsWith(key) || normalizedCandidate.contains(' ' + key);
+}
+
+QStringList SearchSuggestions::merge(const QString& key, const QStringList& results) const
+{
+    QStringList merged;
+    QStringList seen;
+
+    auto add = [&merged, &seen](const QString& suggestion) {
+        const QString normalizedSuggestion = normalized(suggestion);
+        if (seen.contains(normalizedSuggestion))
+            return;
+        seen.append(normalizedSuggestion);
+        merged.append(suggestion);
+    };
+
+    // turning history off hides what was kept before too, short of clearing it
+    for (const QString& entry : qtTubeApp->settings().searchHistory ? m_history : QStringList())
+    {
+        if (merged.size() >= MaxHistoryMatches)
+            break;
+        if (matches(entry, key))
+            add(entry);
+    }
+
+    for (const QString& result : results)
+    {
+        if (merged.size() >= MaxSuggestions)
+            break;
+        add(result);
+    }
+
+    return merged;
+}
+
+QString SearchSuggestions::normalized(const QString& text)
+{
+    return text.simplified().toLower();
+}
+
+void SearchSuggestions::request(const QString& text)
+{
+    // whatever's waiting or out there now is for older text
+    cancel();
+
+    const QString key = normalized(text);
+    if (key.isEmpty())
+    {
+        emit ready(text, {});
+        return;
+    }
+
+    if (auto it = std::ranges::find(m_cache, key, &CacheEntry::prefix); it != m_cache.end())
+    {
+        const QStringList results = it->results;
+        insertCache(key, results); // bump it
+        emit ready(text, merge(key, results));
+        return;
+    }
+
+    // the longest cached prefix of the query, narrowed down to what still matches
+    auto longest = m_cache.cend();
+    for (auto it = m_cache.cbegin(); it != m_cache.cend(); ++it)
+        if (key.startsWith(it->prefix) && (longest == m_cache.cend() || it->prefix.size() > longest->prefix.size()))
+            longest = it;
+
+    QStringList narrowed;
+    bool exhaustive{};
+    if (longest != m_cache.cend())
+    {
+        for (const QString& result : longest->results)
+            if (matches(result, key))
+                narrowed.append(result);
+        exhaustive = longest->results.size() < ServerLimit;
+    }
+
+    emit ready(text, merge(key, narrowed));
+    if (exhaustive || narrowed.size() >= MinLocalMatches)
+        return;
+
+    m_pending = text;
+    m_debounceTimer->start();
+}
+
+void SearchSuggestions::saveHistory() const
+{
+    QDir().mkpath(QFileInfo(m_historyPath).absolutePath());
+
+    QFile file(m_historyPath);
+    if (file.open(QFile::WriteOnly | QFile::Truncate))
+        file.write(QJsonDocument(QJsonArray::fromStringList(m_history)).toJson(QJsonDocument::Compact));
+    else
+        qWarning() << "Failed to save search history:" << file.errorString();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <mutex>
+#include <QObject>
+#include <QStringList>
+#include <QUrl>
+
+class QTimer;
+
+// search box suggestions. typing is debounced into at most one request at a time, with anything superseded
+// dropped (or ignored if it's already out). answers are kept per prefix in a small LRU cache, and since
+// narrowing a query can only narrow its suggestions, most keystrokes are answered by filtering what's cached.
+// past searches and watched video titles are mixed in first, if the searchHistory setting allows keeping them.
+class SearchSuggestions : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int DebounceInterval = 150;
+    static constexpr int MaxCachedPrefixes = 64;
+    static constexpr int MaxHistory = 200;
+    static constexpr int MaxHistoryMatches = 3;
+    static constexpr int MaxSuggestions = 10;
+    // narrowed results fewer than this still go to the server, unless the cached prefix was exhaustive
+    static constexpr int MinLocalMatches = 5;
+
+    static SearchSuggestions* instance();
+    explicit SearchSuggestions(QObject* parent = nullptr);
+
+    // something searched for or watched, for suggestions to match against later. saved straight away.
+    void addToHistory(const QString& text);
+    // drops whatever's pending for the last request() (the search went through, or the box was cleared)
+    void cancel();
+    // forgets every past search and watched video, on disk too
+    void clearHistory();
+    // suggestions for text come back through ready(). local results are sent straight away,
+    // a request only goes out once typing settles, and only if they weren't enough.
+    void request(const QString& text);
+    // where suggestions are fetched from. anything answering with the same JSON works, e.g. a local server for testing.
+    void setServerUrl(const QUrl& url) { m_serverUrl = url; }
+private:
+    struct CacheEntry
+    {
+        QString prefix; // normalized
+        QStringList results;
+    };
+
+    static inline SearchSuggestions* m_instance;
+    static inline std::once_flag m_onceFlag;
+
+    QList<CacheEntry> m_cache; // most recently used first
+    QTimer* m_debounceTimer;
+    quint64 m_generation{};
+    QStringList m_history; // most recent first
+    QString m_historyPath;
+    QString m_pending;
+    QUrl m_serverUrl;
+
+    static QString normalized(const QString& text);
+    static bool matches(const QString& candidate, const QString& key);
+
+    void fetch();
+    void insertCache(const QString& prefix, const QStringList& results);
+    void loadHistory();
+    QStringList merge(const QString& key, const QStringList& results) const;
+    void saveHistory() const;
+signals:
+    void ready(const QString& text, const QStringList& suggestions);
+};
@@ -0,0 +1,144 @@
+#include "tracing.h"
+#include <atomic>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QTextStream>
+#include <QThread>
+
+namespace Tracing
+{
+    namespace
+    {
+        struct Event
+        {
+            const char* category;
+            qint64 duration;
+            quint64 id;
+            const char* name;
+            char phase;
+            quint64 threadId;
+            qint64 timestamp;
+        };
+
+        QElapsedTimer g_clock;
+        std::atomic_bool g_enabled;
+        QList<Event> g_events;
+        QMutex g_mutex;
+        std::atomic<quint64> g_nextId{1};
+        QString g_outputPath;
+
+        qint64 now()
+        {
+            return g_clock.nsecsElapsed() / 1000;
+        }
+
+        void record(const char* name, const char* category, char phase, qint64 timestamp, qint64 duration = 0, quint64 id = 0)
+        {
+            QMutexLocker locker(&g_mutex);
+            g_events.append(Event {
+                .category = category,
+                .duration = duration,
+                .id = id,
+                .name = name,
+                .phase = phase,
+                .threadId = reinterpret_cast<quintptr>(QThread::currentThreadId()),
+                .timestamp = timestamp
+            });
+        }
+    }
+
+    Span::Span(const char* name, const char* category) : m_category(category), m_name(name)
+    {
+        if (g_enabled)
+            m_start = now();
+    }
+
+    Span::~Span()
+    {
+        if (g_enabled && m_start != -1)
+            record(m_name, m_category, 'X', m_start, now() - m_start);
+    }
+
+    quint64 asyncBegin(const char* name, const char* category)
+    {
+        if (!g_enabled)
+            return 0;
+
+        quint64 id = g_nextId++;
+        record(name, category, 'b', now(), 0, id);
+        return id;
+    }
+
+    void asyncEnd(const char* name, quint64 id, const char* category)
+    {
+        if (g_enabled && id != 0)
+            record(name, category, 'e', now(), 0, id);
+    }
+
+    bool enabled()
+    {
+        return g_enabled;
+    }
+
+    void start(const QString& outputPath)
+    {
+        if (g_enabled)
+            return;
+
+        g_outputPath = outputPath;
+        g_clock.start();
+        g_enabled = true;
+
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit, qApp, [] { stop(); });
+    }
+
+    void stop()
+    {
+        if (!g_enabled.exchange(false))
+            return;
+
+        QMutexLocker locker(&g_mutex);
+        const qint64 pid = QCoreApplication::applicationPid();
+
+        QJsonArray traceEvents;
+        for (const Event& event : std::as_const(g_events))
+        {
+            QJsonObject obj {
+                { "cat", event.category },
+                { "name", event.name },
+                { "ph", QString(QLatin1Char(event.phase)) },
+                { "pid", pid },
+                { "tid", QString::number(event.threadId) },
+                { "ts", event.timestamp }
+            };
+
+            if (event.phase == 'X')
+                obj.insert("dur", event.duration);
+            else if (event.id != 0)
+                obj.insert("id", QString::number(event.id));
+
+            traceEvents.append(obj);
+        }
+
+        g_events.clear();
+
+        QFile file(g_outputPath);
+        if (!file.open(QFile::WriteOnly | QFile::Truncate))
+        {
+            qWarning().nospace() << "Failed to write trace to " << g_outputPath << ": " << file.errorString();
+            return;
+        }
+
+        file.write(QJsonDocument(QJsonObject {
+            { "displayTimeUnit", "ms" },
+            { "traceEvents", traceEvents }
+        }).toJson(QJsonDocument::Compact));
+        QTextStream(stderr) << "Wrote trace with " << traceEvents.size() << " events to " << g_outputPath << Qt::endl;
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <QString>
+
+// records chrome trace-event json (viewable in about:tracing or ui.perfetto.dev).
+// everything here is a no-op until start() is called, which only happens with --trace,
+// so spans are fine to leave in hot paths. names and categories must outlive the trace (use literals).
+namespace Tracing
+{
+    // times the enclosing scope.
+    class Span
+    {
+    public:
+        explicit Span(const char* name, const char* category = "app");
+        ~Span();
+        Q_DISABLE_COPY(Span)
+    private:
+        const char* m_category;
+        const char* m_name;
+        qint64 m_start = -1;
+    };
+
+    // async flows are for work that finishes somewhere else, like a network reply.
+    // asyncBegin returns 0 when tracing is off, and asyncEnd ignores 0.
+    quint64 asyncBegin(const char* name, const char* category = "app");
+    void asyncEnd(const char* name, quint64 id, const char* category = "app");
+
+    bool enabled();
+    void start(const QString& outputPath);
+    void stop();
+}
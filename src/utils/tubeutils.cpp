@@ -1,12 +1,19 @@
 #include "tubeutils.h"
-#include "http.h"
 #include "innertube.h"
 #include "protobuf/protobufutil.h"
 #include "qttubeapplication.h"
+#include "utils/metadatacache.h"
+#include "utils/networkmetrics.h"
+#include <QImageReader>
 #include <QNetworkReply>
 #include <QRandomGenerator>
 #include <QUrlQuery>
 
+// widths of the 16:9 area in each i.ytimg.com variant. the 4:3 ones are letterboxed, VideoThumbnailWidget crops that off.
+constexpr std::array<std::pair<int, const char*>, 5> ThumbnailVariants = {{
+    { 120, "default" }, { 320, "mqdefault" }, { 480, "hqdefault" }, { 640, "sddefault" }, { 1280, "hq720" }
+}};
+
 namespace TubeUtils
 {
     QFuture<std::pair<QString, bool>> getSubCount(const QString& channelId, const QString& fallback)
@@ -21,12 +28,12 @@ namespace TubeUtils
             return futureInterface.future();
         }
 
-        HttpReply* reply = Http::instance().get("https://api.socialcounts.org/youtube-live-subscriber-count/" + channelId);
-        QObject::connect(reply, &HttpReply::finished, [fallback, futureInterface](const HttpReply& reply) mutable {
-            if (reply.isSuccessful())
+        MetadataCache::instance()->get(MetadataCache::Source::SocialCounts, channelId, nullptr,
+                                       [fallback, futureInterface](const QByteArray& body) mutable {
+            if (!body.isEmpty())
             {
                 static QRegularExpression estSubRegex("\"est_sub\":(\\d+)");
-                if (QRegularExpressionMatch match = estSubRegex.match(reply.body()); match.hasCaptured(1))
+                if (QRegularExpressionMatch match = estSubRegex.match(body); match.hasCaptured(1))
                     futureInterface.reportResult(std::make_pair(QLocale::system().toString(match.captured(1).toInt()), true));
                 else
                     futureInterface.reportResult(std::make_pair(fallback, false));
@@ -42,29 +49,44 @@ namespace TubeUtils
         return futureInterface.future();
     }
 
-    QString getUcidFromUrl(const QString& url)
+    QFuture<QString> getUcidFromUrl(const QString& url)
     {
-        QString ucid;
+        QFutureInterface<QString> futureInterface;
+        futureInterface.reportStarted();
 
-        try
-        {
-            auto reply = InnerTube::instance()->getBlocking<InnertubeEndpoints::ResolveUrl>(url);
-            ucid = reply.endpoint["browseEndpoint"]["browseId"].toString();
+        auto finish = [futureInterface](const QString& ucid) mutable {
+            futureInterface.reportResult(ucid);
+            futureInterface.reportFinished();
+        };
 
+        auto resolve = [](const QString& url, auto&& callback) {
+            using UrlReply = InnertubeReply<InnertubeEndpoints::ResolveUrl>;
+            auto reply = InnerTube::instance()->get<InnertubeEndpoints::ResolveUrl>(url);
+            NetworkMetrics::instance()->track(reply, "ResolveUrl");
+            QObject::connect(reply, &UrlReply::exception, reply, [callback](const InnertubeException& ex) mutable {
+                qDebug() << ex.message();
+                callback(QJsonValue());
+            });
+            QObject::connect(reply, &UrlReply::finished, reply, [callback](const InnertubeEndpoints::ResolveUrl& endpoint) mutable {
+                callback(endpoint.endpoint);
+            });
+        };
+
+        resolve(url, [finish, resolve](const QJsonValue& endpoint) mutable {
             // check for an edge case where a classic channel URL is returned instead of the UCID
-            if (ucid.isEmpty() && reply.endpoint["urlEndpoint"]["url"].isString())
+            if (QString classicUrl = endpoint["urlEndpoint"]["url"].toString();
+                endpoint["browseEndpoint"]["browseId"].toString().isEmpty() && !classicUrl.isEmpty())
             {
-                QString classicUrl = reply.endpoint["urlEndpoint"]["url"].toString();
-                auto reply2 = InnerTube::instance()->getBlocking<InnertubeEndpoints::ResolveUrl>(classicUrl);
-                ucid = reply.endpoint["browseEndpoint"]["browseId"].toString();
+                resolve(classicUrl, [finish](const QJsonValue& endpoint2) mutable {
+                    finish(endpoint2["browseEndpoint"]["browseId"].toString());
+                });
+                return;
             }
-        }
-        catch (const InnertubeException& ex)
-        {
-            qDebug() << ex.message();
-        }
 
-        return ucid;
+            finish(endpoint["browseEndpoint"]["browseId"].toString());
+        });
+
+        return futureInterface.future();
     }
 
     void reportPlayback(const InnertubeEndpoints::PlayerResponse& playerResp)
@@ -137,4 +159,32 @@ namespace TubeUtils
         http.addRequestHeader("X-YOUTUBE-CLIENT-VERSION", context->client.clientVersion.toLatin1());
         http.addRequestHeader("X-ORIGIN", "https://www.youtube.com");
     }
+
+    QString smallerVideoThumbnailUrl(const QString& url)
+    {
+        // only urls from videoThumbnailUrl(). the ones in responses are signed, so they can't just be renamed.
+        static QRegularExpression variantRegex(R"(^(https://i\.ytimg\.com/vi(?:_webp)?/[^/?]+/)(\w+)(\.\w+)$)");
+        const QRegularExpressionMatch match = variantRegex.match(url);
+        if (!match.hasMatch())
+            return QString();
+
+        auto variant = std::ranges::find_if(ThumbnailVariants, [name = match.captured(2)](const auto& v) { return name == v.second; });
+        // every video has mqdefault. below that is default, which is what's used as the placeholder anyway.
+        if (variant == ThumbnailVariants.end() || std::distance(ThumbnailVariants.begin(), variant) <= 1)
+            return QString();
+
+        return match.captured(1) + QString::fromLatin1(std::prev(variant)->second) + match.captured(3);
+    }
+
+    QString videoThumbnailUrl(const QString& videoId, int minWidth)
+    {
+        static const bool webpSupported = QImageReader::supportedImageFormats().contains("webp");
+
+        auto variant = std::ranges::find_if(ThumbnailVariants, [minWidth](const auto& v) { return v.first >= minWidth; });
+        const QString name = QString::fromLatin1(variant != ThumbnailVariants.end() ? variant->second : ThumbnailVariants.back().second);
+
+        return webpSupported
+            ? QStringLiteral("https://i.ytimg.com/vi_webp/%1/%2.webp").arg(videoId, name)
+            : QStringLiteral("https://i.ytimg.com/vi/%1/%2.jpg").arg(videoId, name);
+    }
 }
@@ -11,7 +11,13 @@ struct InnertubeContext;
 namespace TubeUtils
 {
     QFuture<std::pair<QString, bool>> getSubCount(const QString& channelId, const QString& fallback = {});
-    QString getUcidFromUrl(const QString& url);
+    // empty if the url couldn't be resolved to a channel
+    QFuture<QString> getUcidFromUrl(const QString& url);
     void reportPlayback(const InnertubeEndpoints::PlayerResponse& playerResp);
     void setNeededHeaders(Http& http, InnertubeContext* context, InnertubeAuthStore* authStore);
+    // the next size down from a videoThumbnailUrl(), for when a video doesn't have the one asked for.
+    // empty if there's nothing smaller worth trying.
+    QString smallerVideoThumbnailUrl(const QString& url);
+    // the smallest i.ytimg.com thumbnail at least minWidth (physical) pixels wide, as webp if Qt can decode it.
+    QString videoThumbnailUrl(const QString& videoId, int minWidth = 0);
 }
@@ -1,5 +1,4 @@
 #include "uiutils.h"
-#include "http.h"
 #include "innertube/objects/ad/adslot.h"
 #include "innertube/objects/backstage/backstagepost.h"
 #include "innertube/objects/channel/channel.h"
@@ -8,7 +7,9 @@
 #include "innertube/objects/video/video.h"
 #include "mainwindow.h"
 #include "qttubeapplication.h"
+#include "ui/widgets/continuablelistwidget.h"
 #include "ui/widgets/dynamiclistwidgetitem.h"
+#include "ui/widgets/findbar.h"
 #include "ui/widgets/labels/tubelabel.h"
 #include "ui/widgets/renderers/backstage/backstagepostrenderer.h"
 #include "ui/widgets/renderers/backstage/postrenderer.h"
@@ -16,6 +17,7 @@
 #include "ui/widgets/renderers/browsenotificationrenderer.h"
 #include "ui/widgets/renderers/video/browsevideorenderer.h"
 #include "ui/widgets/renderers/video/gridvideorenderer.h"
+#include "utils/httputils.h"
 #include <QClipboard>
 #include <QFile>
 #include <QLayout>
@@ -46,6 +48,24 @@ constexpr QLatin1String DarkStylesheet(R"(
     }
 )");
 
+namespace
+{
+    // rows go on the end, unless a refresh is being merged into the list
+    void insertListItem(QListWidget* list, QListWidgetItem* item)
+    {
+        if (auto* continuable = qobject_cast<ContinuableListWidget*>(list); continuable && continuable->isMerging())
+            continuable->insertMergedItem(item);
+        else
+            list->addItem(item);
+    }
+
+    bool keptByMerge(QListWidget* list, const QString& videoId)
+    {
+        auto* continuable = qobject_cast<ContinuableListWidget*>(list);
+        return continuable && continuable->keepMergedRow(videoId);
+    }
+}
+
 namespace UIUtils
 {
     QString g_defaultStyle;
@@ -78,7 +98,7 @@ namespace UIUtils
 
         if (const InnertubeObjects::GenericThumbnail* recAvatar = channel.thumbnail.recommendedQuality(QSize(80, 80)))
         {
-            HttpReply* reply = Http::instance().get("https:" + recAvatar->url);
+            HttpReply* reply = HttpUtils::get("https:" + recAvatar->url, false, RequestPriority::Visible, renderer);
             QObject::connect(reply, &HttpReply::finished, renderer, &BrowseChannelRenderer::setThumbnail);
         }
     }
@@ -91,12 +111,13 @@ namespace UIUtils
 
         if (const InnertubeObjects::GenericThumbnail* recAvatar = notification.channelIcon.recommendedQuality(QSize(48, 48)))
         {
-            HttpReply* iconReply = Http::instance().get(recAvatar->url);
+            HttpReply* iconReply = HttpUtils::get(recAvatar->url, false, RequestPriority::Visible, renderer);
             QObject::connect(iconReply, &HttpReply::finished, renderer, &BrowseNotificationRenderer::setChannelIcon);
         }
 
         // notification.videoThumbnail returns images with black bars, so we're going to use mqdefault instead
-        HttpReply* thumbReply = Http::instance().get("https://i.ytimg.com/vi/" + notification.videoId + "/mqdefault.jpg");
+        HttpReply* thumbReply = HttpUtils::get(
+            "https://i.ytimg.com/vi/" + notification.videoId + "/mqdefault.jpg", false, RequestPriority::Visible, renderer);
         QObject::connect(thumbReply, &HttpReply::finished, renderer, &BrowseNotificationRenderer::setThumbnail);
     }
 
@@ -111,13 +132,15 @@ namespace UIUtils
 
         QListWidgetItem* item = new QListWidgetItem;
         item->setSizeHint(renderer->size());
-        list->addItem(item);
+        insertListItem(list, item);
         list->setItemWidget(item, renderer);
+        FindBar::indexListItem(item, renderer);
     }
 
     QListWidgetItem* addResizingWidgetToList(QListWidget* list, QWidget* widget)
     {
-        DynamicListWidgetItem* item = new DynamicListWidgetItem(list);
+        DynamicListWidgetItem* item = new DynamicListWidgetItem(nullptr);
+        insertListItem(list, item);
         item->setWidget(widget);
         return item;
     }
@@ -134,7 +157,7 @@ namespace UIUtils
 
         QListWidgetItem* item = new QListWidgetItem;
         item->setSizeHint(hint);
-        list->addItem(item);
+        insertListItem(list, item);
         list->setItemWidget(item, line);
     }
 
@@ -157,8 +180,9 @@ namespace UIUtils
 
         QListWidgetItem* item = new QListWidgetItem;
         item->setSizeHint(hint);
-        list->addItem(item);
+        insertListItem(list, item);
         list->setItemWidget(item, shelfLabel);
+        FindBar::indexListItem(item, shelfLabel);
     }
 
     void addVideoToList(QListWidget* list, const InnertubeObjects::AdSlot& adSlot,
@@ -177,53 +201,54 @@ namespace UIUtils
     void addVideoToList(QListWidget* list, const InnertubeObjects::LockupViewModel& lockup,
                         bool useThumbnailFromData)
     {
-        if (qtTubeApp->settings().videoIsFiltered(lockup))
+        if (qtTubeApp->settings().videoIsFiltered(lockup) || keptByMerge(list, lockup.contentId))
             return;
 
         VideoRenderer* renderer = constructVideoRenderer(list);
         renderer->setData(lockup, useThumbnailFromData);
-        addWidgetToList(list, renderer);
+        addWidgetToList(list, renderer)->setData(ContinuableListWidget::VideoIdRole, lockup.contentId);
     }
 
     void addVideoToList(QListWidget* list, const InnertubeObjects::Reel& reel,
                         bool useThumbnailFromData)
     {
-        if (qtTubeApp->settings().videoIsFiltered(reel))
+        if (qtTubeApp->settings().videoIsFiltered(reel) || keptByMerge(list, reel.videoId))
             return;
 
         VideoRenderer* renderer = constructVideoRenderer(list);
         renderer->setData(reel, list->flow() == QListWidget::LeftToRight, useThumbnailFromData);
-        addWidgetToList(list, renderer);
+        addWidgetToList(list, renderer)->setData(ContinuableListWidget::VideoIdRole, reel.videoId);
     }
 
     void addVideoToList(QListWidget* list, const InnertubeObjects::ShortsLockupViewModel& shortsLockup,
                         bool useThumbnailFromData)
     {
-        if (qtTubeApp->settings().videoIsFiltered(shortsLockup))
+        if (qtTubeApp->settings().videoIsFiltered(shortsLockup) || keptByMerge(list, shortsLockup.videoId))
             return;
 
         VideoRenderer* renderer = constructVideoRenderer(list);
         renderer->setData(shortsLockup, list->flow() == QListWidget::LeftToRight, useThumbnailFromData);
-        addWidgetToList(list, renderer);
+        addWidgetToList(list, renderer)->setData(ContinuableListWidget::VideoIdRole, shortsLockup.videoId);
     }
 
     void addVideoToList(QListWidget* list, const InnertubeObjects::Video& video,
                         bool useThumbnailFromData)
     {
-        if (qtTubeApp->settings().videoIsFiltered(video))
+        if (qtTubeApp->settings().videoIsFiltered(video) || keptByMerge(list, video.videoId))
             return;
 
         VideoRenderer* renderer = constructVideoRenderer(list);
         renderer->setData(video, useThumbnailFromData);
-        addWidgetToList(list, renderer);
+        addWidgetToList(list, renderer)->setData(ContinuableListWidget::VideoIdRole, video.videoId);
     }
 
     QListWidgetItem* addWidgetToList(QListWidget* list, QWidget* widget)
     {
         QListWidgetItem* item = new QListWidgetItem;
         item->setSizeHint(widget->sizeHint());
-        list->addItem(item);
+        insertListItem(list, item);
         list->setItemWidget(item, widget);
+        FindBar::indexListItem(item, widget);
         return item;
     }
 
@@ -370,7 +395,7 @@ namespace UIUtils
         if (!best)
             return;
 
-        HttpReply* reply = Http::instance().get(QUrl(best->url));
+        HttpReply* reply = HttpUtils::get(QUrl(best->url), false, RequestPriority::Visible, label);
         QObject::connect(reply, &HttpReply::finished, reply, [label](const HttpReply& reply)
         {
             QPixmap pixmap;
@@ -1,4 +1,5 @@
 #pragma once
+#include "tracing.h"
 #include <initializer_list>
 #include <QCoreApplication>
 #include <QWidget>
@@ -101,10 +102,14 @@ namespace UIUtils
     {
         for (auto it = std::ranges::begin(range); it != std::ranges::end(range); ++it)
         {
-            if constexpr (detail::is_variant_v<std::ranges::range_value_t<decltype(range)>>)
-                std::visit([list](auto&& item) { addItemToList(list, item); }, *it);
-            else
-                addItemToList(list, *it);
+            {
+                // scoped so the span doesn't include processEvents()
+                Tracing::Span span("UIUtils::addItemToList", "render");
+                if constexpr (detail::is_variant_v<std::ranges::range_value_t<decltype(range)>>)
+                    std::visit([list](auto&& item) { addItemToList(list, item); }, *it);
+                else
+                    addItemToList(list, *it);
+            }
             QCoreApplication::processEvents();
         }
     }